@@ -6,6 +6,8 @@
  *                          a CR/LF with every instance. Might be better without them.
  *            04 OCT 2021 - Corrected typo in line 136
  *            15 JAN 2022 - Added timeout for unrecognized repsonse to prompt.
+ *            16 OCT 2026 - `scanAddr()` uses the library `discover()` function
+ *                          so that only TFMini-Plus devices are listed.
  *
  * Description: Run an I2C address search.
  *              Use first address found as old address.
@@ -19,45 +21,39 @@
                       // devices such as the Galileo. Download from:
                       // https://github.com/spaniakos/AES/blob/master/printf.h
 
-#include <TFMPI2C.h>  // TFMini-Plus I2C Library v1.7.3
+#include <TFMPI2C.h>  // TFMini-Plus I2C Library v1.8.0
 TFMPI2C tfmP;         // Create a TFMini-Plus I2C object
 
 // Declare variables
-int I2C_total, I2C_error;
+uint8_t I2C_total;
 uint8_t oldAddr, newAddr;
+TFMPDevice devList[ 8];  // TFMini-Plus devices found by `discover()`
 
 bool scanAddr()
 {
     Serial.println();
-    Serial.println( "Show all I2C addresses in Decimal and Hex.");
+    Serial.println( "Show all TFMini-Plus addresses in Decimal and Hex.");
     Serial.println( "Scanning...");
-    I2C_total = 0;
-    I2C_error = 0;
     oldAddr = 0x10; // default address
-    for( uint8_t x = 1; x < 127; x++ )
+    // Probe every address and ask each device that answers for its
+    // firmware version.  Only a device that replies properly counts.
+    I2C_total = tfmP.discover( devList, 8);
+    for( uint8_t i = 0; i < I2C_total; i++)
     {
-        Wire.beginTransmission( x);
-        // Use return value of Write.endTransmisstion() to
-        // see if a device did acknowledge the I2C address.
-        I2C_error = Wire.endTransmission();
-
-        if( I2C_error == 0)
-        {
-            Serial.print( "I2C device found at address ");
-            printAddress( x);
-            ++I2C_total;   //  Increment for each address returned.
-            if( I2C_total == 1) oldAddr = x;
-        }
-        else if( I2C_error == 4)
-        {
-            Serial.print( "Unknown I2C error at address ");
-            Serial.println( x);
-        }
+        Serial.print( "TFMini-Plus v");
+        Serial.print( devList[ i].version[ 0]);
+        Serial.print( ".");
+        Serial.print( devList[ i].version[ 1]);
+        Serial.print( ".");
+        Serial.print( devList[ i].version[ 2]);
+        Serial.print( " found at address ");
+        printAddress( devList[ i].addr);
     }
+    if( I2C_total > 0) oldAddr = devList[ 0].addr;
     //  Display results and return boolean value.
     if( I2C_total == 0)
     {
-      Serial.println( "No I2C devices found.");
+      Serial.println( "No TFMini-Plus devices found.");
       return false;
     }
     else return true;
@@ -102,7 +98,7 @@ void loop()
     if( scanAddr())
     {
       Serial.println();
-      Serial.print( "First I2C address found: ");
+      Serial.print( "First TFMini-Plus address found: ");
       printAddress( oldAddr);
       Serial.print( "Enter new address from 1 to 127 decimal (not Hex): ");
 
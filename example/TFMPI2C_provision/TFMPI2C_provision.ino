@@ -0,0 +1,115 @@
+/* File Name: TFMPI2C_provision.ino
+ * Developer: Bud Ryerson
+ * Inception: 16 OCT 2026
+ *
+ * Description: Give each of several TFMini-Plus sensors, all still at
+ *              the factory default address of 0x10, an I2C address of
+ *              its own in a single pass.
+ *
+ * Each sensor's power or enable line must be switched by its own pin.
+ * List those pins in `enablePins[]`, in the order that the addresses
+ * should be given.  The first sensor gets `FIRST_ADDRESS`, the next
+ * one `FIRST_ADDRESS + 1`, and so on.
+ *
+ * Sensors are switched on one at a time.  Each is given its address,
+ * told to save its settings, and then checked at the new address.
+ * A sensor that fails is switched off again and the reason is shown.
+ * Open the Serial Monitor and enter 'Y' to start.
+ */
+
+#include <Wire.h>           // Arduino standard I2C/Two-Wire Library
+#include <TFMPI2C.h>        // TFMini-Plus I2C Library v1.8.0
+#include <TFMPProvision.h>  // Bulk address provisioning
+
+#define SENSOR_COUNT   4
+#define FIRST_ADDRESS  0x20
+
+const uint8_t enablePins[ SENSOR_COUNT] = { 4, 5, 6, 7 };
+
+TFMPI2C tfmP;                  // Create a TFMini-Plus I2C object
+TFMPProvision prov( tfmP);     // and a provisioning object that uses it
+TFMPProvResult results[ SENSOR_COUNT];
+
+// Print address in decimal and HEX
+void printAddress( uint8_t adr)
+{
+    Serial.print( adr);
+    Serial.print( " (0x");
+    Serial.print( adr < 16 ? "0" : "");
+    Serial.print( adr, HEX);
+    Serial.print( " Hex)");
+}
+
+// Print the meaning of a provisioning result code
+void printResult( uint8_t result)
+{
+    if( result == TFMP_PROV_OK)           Serial.print( "passed");
+    else if( result == TFMP_PROV_BUSY)    Serial.print( "default address busy before start");
+    else if( result == TFMP_PROV_ABSENT)  Serial.print( "no reply at default address");
+    else if( result == TFMP_PROV_TAKEN)   Serial.print( "new address already in use");
+    else if( result == TFMP_PROV_ADDRESS) Serial.print( "set address failed");
+    else if( result == TFMP_PROV_SAVE)    Serial.print( "save settings failed");
+    else if( result == TFMP_PROV_VERIFY)  Serial.print( "no reply at new address");
+    else if( result == TFMP_PROV_RANGE)   Serial.print( "address range not allowed");
+    else                                  Serial.print( "skipped");
+}
+
+void setup()
+{
+    Serial.begin( 115200);   // Initialize terminal serial port
+    delay(20);
+    tfmP.recoverI2CBus();    // Also calls `Wire.begin()`
+
+    prov.setPins( enablePins);   // Enable pins are active HIGH
+
+    Serial.println();
+    Serial.println( "*****************************");
+    Serial.print( "Provision ");
+    Serial.print( SENSOR_COUNT);
+    Serial.print( " sensors starting at address ");
+    printAddress( FIRST_ADDRESS);
+    Serial.println();
+    Serial.print( "Start ");
+}
+
+// = = = = = = = = = =  MAIN LOOP  = = = = = = = = = =
+void loop()
+{
+    if( tfmP.getResponse())
+    {
+        Serial.println();
+        uint32_t start = millis();
+        uint8_t passed = prov.run( SENSOR_COUNT, FIRST_ADDRESS, results);
+
+        for( uint8_t i = 0; i < SENSOR_COUNT; i++)
+        {
+            Serial.print( "Sensor ");
+            Serial.print( i);
+            Serial.print( " on pin ");
+            Serial.print( enablePins[ i]);
+            Serial.print( ", address ");
+            printAddress( results[ i].addr);
+            Serial.print( ": ");
+            printResult( results[ i].result);
+            if( results[ i].result == TFMP_PROV_OK)
+            {
+                Serial.print( ", firmware ");
+                Serial.print( results[ i].version[ 0]);
+                Serial.print( ".");
+                Serial.print( results[ i].version[ 1]);
+                Serial.print( ".");
+                Serial.print( results[ i].version[ 2]);
+            }
+            Serial.println();
+        }
+        Serial.print( passed);
+        Serial.print( " of ");
+        Serial.print( SENSOR_COUNT);
+        Serial.print( " passed in ");
+        Serial.print( millis() - start);
+        Serial.println( "ms.");
+        Serial.println( "*****************************");
+    }
+    Serial.print( "Start again ");
+}
+// = = = = = = = = =  End of Main Loop  = = = = = = = = =
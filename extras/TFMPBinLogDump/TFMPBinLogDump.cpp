@@ -0,0 +1,102 @@
+/* File Name: TFMPBinLogDump.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Described: Host program to decode a TFMPI2C binary sample log
+ *            and print it as comma separated text.
+ *
+ *  Build on the host computer with:
+ *    g++ -O2 -I../../src TFMPBinLogDump.cpp ../../src/TFMPBinLog.cpp -o tfmpdump
+ *  Use:
+ *    ./tfmpdump capture.bin > capture.csv
+ *    or read the log from standard input if no file is named.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "TFMPBinLog.h"
+
+int main( int argc, char *argv[])
+{
+    FILE *in = ( argc > 1) ? fopen( argv[ 1], "rb") : stdin;
+    if( in == NULL)
+    {
+      fprintf( stderr, "Cannot open %s\n", argv[ 1]);
+      return 1;
+    }
+
+    static uint8_t data[ 4096];
+    size_t len = 0;          // bytes waiting in `data`
+    bool header = false;
+    unsigned long records = 0, skipped = 0;
+    TFMPBinLogReader log;
+    TFMPBinLogRecord rec;
+
+    for( ;;)
+    {
+      size_t got = fread( &data[ len], 1, sizeof( data) - len, in);
+      len += got;
+      size_t pos = 0;
+      for( ;;)
+      {
+        size_t used;
+        if( !header)
+        {
+          used = log.readHeader( &data[ pos], len - pos);
+          if( used == 0 && log.status == TFMP_BINLOG_MAGIC)
+          {
+            fprintf( stderr, "Not a TFMPI2C binary log.\n");
+            return 1;
+          }
+          if( used == 0 && log.status == TFMP_BINLOG_VERSION_ERR)
+          {
+            fprintf( stderr, "Log format version %u is not supported.\n", data[ pos + 4]);
+            return 1;
+          }
+          if( used != 0)
+          {
+            header = true;
+            printf( "# version %u, keyframe every %u, %u sensor(s)\n",
+                    log.version, log.keyInterval, log.sensors);
+            for( uint8_t i = 0; i < log.sensors; i++)
+            {
+              printf( "# sensor %u: address 0x%02X, %s\n", i, log.addr[ i],
+                      log.units[ i] == TFMP_BINLOG_MM ? "mm" : "cm");
+            }
+            printf( "sensor,time_us,dist,flux,temp,status\n");
+          }
+        }
+        else
+        {
+          used = log.readRecord( &data[ pos], len - pos, rec);
+          if( log.status == TFMP_BINLOG_OK)
+          {
+            ++records;
+            printf( "%u,%lu,%d,%d,%d,%u\n", rec.sensor, (unsigned long)rec.time,
+                    rec.dist, rec.flux, rec.temp, rec.status);
+          }
+          else if( log.status == TFMP_BINLOG_NOKEY) ++skipped;
+          else if( log.status != TFMP_BINLOG_SHORT)
+          {
+            used = 1;        // Bad byte, so skip it and resync.
+            ++skipped;
+          }
+        }
+        if( used == 0) break;
+        pos += used;
+      }
+      // Move any partial record to the front of the buffer.
+      memmove( data, &data[ pos], len - pos);
+      len -= pos;
+      if( got == 0) break;
+    }
+
+    fprintf( stderr, "%lu records decoded, %lu skipped.\n", records, skipped);
+    if( in != stdin) fclose( in);
+    if( len > 0)
+    {
+      fprintf( stderr, "%lu bytes at the end could not be decoded.\n",
+               (unsigned long)len);
+      return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+/* File Name: TFMPFaultBench.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Described: Host program to measure TFMPI2C throughput on a faulty bus.
+ *
+ *  A simulated TFMini-Plus answers frame requests in real time, as if
+ *  on a bus at the given clock rate.  A `TFMPFaultBus` between it and
+ *  the library makes writes NACK, reads come up short or corrupted,
+ *  and transfers stretch, each at the same rate, for a range of error
+ *  rates.  For each rate it prints good frames per second and the count
+ *  of each error status.
+ *
+ *  Then the bus is made to stick every so often.  The loop treats three
+ *  failed reads in a row as a stuck bus, releases it, as `recoverI2CBus()`
+ *  would on an Arduino, and reads again.  It prints the mean and worst
+ *  time from the first failed read to the next good frame.
+ *
+ *  Build on the host computer with:
+ *    g++ -O2 -I../../src TFMPFaultBench.cpp ../../src/TFMPI2C.cpp \
+ *        ../../src/TFMPBus.cpp ../../src/TFMPFaultBus.cpp -o tfmpbench
+ *  Use:
+ *    ./tfmpbench [clock in Hz, default 400000] [seconds per test, default 1]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "TFMPI2C.h"
+#include "TFMPFaultBus.h"
+
+// One TFMini-Plus at the default address, with a bus that takes
+// as long as the real one would.  Only frame requests are answered.
+class SimBus : public TFMPBus
+{
+  public:
+    SimBus( uint32_t clock) : bitNanos( 1000000000UL / clock), frameLen( 0) {}
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len)
+    {
+      spin( len + 1);
+      if( addr != TFMP_DEFAULT_ADDRESS) return TFMP_BUS_NACK_ADDR;
+      if( len >= 3 && data[ 2] == 0x00)
+      {
+        uint16_t dist = 100 + ( micros() / 10000) % 50;
+        uint8_t f[ TFMP_FRAME_SIZE] = { 0x59, 0x59, uint8_t( dist), uint8_t( dist >> 8),
+                                        0xF4, 0x01, 0x08, 0x09, 0 };
+        for( uint8_t i = 0; i < TFMP_FRAME_SIZE - 1; i++) f[ TFMP_FRAME_SIZE - 1] += f[ i];
+        memcpy( frame, f, sizeof( frame));
+        frameLen = TFMP_FRAME_SIZE;
+      }
+      return TFMP_BUS_OK;
+    }
+
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len)
+    {
+      spin( len + 1);
+      if( addr != TFMP_DEFAULT_ADDRESS) return 0;
+      uint8_t count = ( len < frameLen) ? len : frameLen;
+      memcpy( data, frame, count);
+      return count;
+    }
+
+  private:
+    uint32_t bitNanos;
+    uint8_t frame[ TFMP_FRAME_SIZE];
+    uint8_t frameLen;
+
+    // Nine clocks for each byte, including the address byte.
+    void spin( uint8_t bytes)
+    {
+      uint32_t us = ( uint32_t( bytes) * 9 * bitNanos + 999) / 1000;
+      uint32_t start = micros();
+      while( micros() - start < us) {}
+    }
+};
+
+int main( int argc, char *argv[])
+{
+    uint32_t clock = ( argc > 1) ? strtoul( argv[ 1], NULL, 0) : 400000UL;
+    uint32_t seconds = ( argc > 2) ? strtoul( argv[ 2], NULL, 0) : 1;
+    if( clock == 0 || seconds == 0)
+    {
+      fprintf( stderr, "Use: %s [clock Hz] [seconds]\n", argv[ 0]);
+      return 1;
+    }
+
+    SimBus sim( clock);
+    TFMPFaultBus fault( sim);
+    TFMPI2C tfm( fault);
+    TFMPSample s;
+    fault.stretchMicros = 200;
+
+    printf( "Bus clock %lu Hz, %lu s per test\n\n", (unsigned long)clock,
+            (unsigned long)seconds);
+    printf( "error%%  frames/s  loss%%  write  read  checksum\n");
+    static const uint16_t rates[] = { 0, 10, 100, 500, 1000 };   // per 10000
+    for( uint8_t r = 0; r < sizeof( rates) / sizeof( rates[ 0]); r++)
+    {
+      fault.clear();
+      fault.stretchMicros = 200;
+      fault.setChance( TFMP_FAULT_NACK, rates[ r]);
+      fault.setChance( TFMP_FAULT_SHORT, rates[ r]);
+      fault.setChance( TFMP_FAULT_CORRUPT, rates[ r]);
+      fault.setChance( TFMP_FAULT_STRETCH, rates[ r]);
+
+      unsigned long good = 0, tries = 0, count[ TFMP_ECHO + 1] = { 0 };
+      uint32_t start = micros();
+      while( micros() - start < seconds * 1000000UL)
+      {
+        ++tries;
+        if( tfm.getData( s)) ++good;
+          else if( s.status <= TFMP_ECHO) ++count[ s.status];
+      }
+      printf( "%5.1f  %8.0f  %5.1f  %5lu  %4lu  %8lu\n",
+              rates[ r] / 100.0, double( good) / seconds,
+              100.0 * ( tries - good) / tries, count[ TFMP_I2CWRITE],
+              count[ TFMP_I2CREAD], count[ TFMP_CHECKSUM]);
+    }
+
+    // - - Stuck bus and recovery - -
+    fault.clear();
+    fault.setEvery( TFMP_FAULT_STUCK, 500);
+    unsigned long frames = 0, recoveries = 0;
+    uint32_t failStart = 0, worst = 0;
+    uint64_t spent = 0;
+    uint8_t fails = 0;
+    uint32_t start = micros();
+    while( micros() - start < seconds * 1000000UL)
+    {
+      if( tfm.getData( s))
+      {
+        ++frames;
+        if( fails > 0)
+        {
+          uint32_t took = micros() - failStart;
+          spent += took;
+          if( took > worst) worst = took;
+          ++recoveries;
+        }
+        fails = 0;
+        continue;
+      }
+      if( fails++ == 0) failStart = micros();
+      if( fails >= 3) fault.release();
+    }
+    printf( "\nStuck bus every 500 transfers, released after 3 failed reads\n");
+    printf( "%lu frames/s, %lu recoveries, mean %lu us, worst %lu us\n",
+            frames / seconds, recoveries,
+            recoveries ? (unsigned long)( spent / recoveries) : 0UL,
+            (unsigned long)worst);
+    return 0;
+}
@@ -0,0 +1,623 @@
+/* File Name: TFMPSelfTest.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Described: Host program to check TFMPI2C library functions against
+ *            simulated TFMini-Plus devices.
+ *
+ *  Each check runs on a simulated bus with its own clock, so the whole
+ *  program takes only a moment no matter how long the devices would
+ *  take.  Every check prints PASS or FAIL and the program returns the
+ *  number that failed.
+ *
+ *  Build on the host computer with:
+ *    g++ -O2 -I../../src TFMPSelfTest.cpp ../../src/TFMPI2C.cpp \
+ *        ../../src/TFMPBus.cpp ../../src/TFMPReplay.cpp \
+ *        ../../src/TFMPPhase.cpp ../../src/TFMPDuplicate.cpp \
+ *        ../../src/TFMPConfig.cpp ../../src/TFMPJitter.cpp \
+ *        ../../src/TFMPScheduler.cpp ../../src/TFMPBinLog.cpp \
+ *        ../../src/TFMPPlanner.cpp ../../src/TFMPTTC.cpp \
+ *        ../../src/TFMPOversample.cpp -o tfmptest
+ *  Add -DTFMP_COMPACT to check a compact build.
+ *  Use:
+ *    ./tfmptest
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "TFMPI2C.h"
+#include "TFMPReplay.h"
+#include "TFMPPhase.h"
+#include "TFMPConfig.h"
+#include "TFMPJitter.h"
+#include "TFMPScheduler.h"
+#include "TFMPBinLog.h"
+#include "TFMPPlanner.h"
+#include "TFMPTTC.h"
+#include "TFMPOversample.h"
+
+// = = = = = = = = = = =  SIMULATED DEVICES  = = = = = = = = = = = =
+//
+#define SIM_DEVICES        4
+#define SIM_TRANSFER     100  // microseconds for each transfer
+#define SIM_START 5000000UL  // bus time at the start, not zero
+
+struct SimDevice
+{
+    uint8_t addr;             // zero if not used
+    bool dropReply;           // lose the reply to SOFT_RESET
+    uint32_t bootMicros;      // start up time after SOFT_RESET
+    uint32_t bootUntil;       // no writes acknowledged until then
+    bool ackBoot;             // acknowledge while starting up, and
+    bool staleBoot;           // answer a frame request with zeros
+                              // or, if stale, with the last frame
+    uint8_t pending[ TFMP_FRAME_SIZE];
+    uint8_t pendingLen;
+    uint8_t last[ TFMP_FRAME_SIZE];   // last frame sent
+    uint32_t period;          // if not zero, a new distance every period
+    uint32_t frameTime;       // time the last frame sent was made
+};
+
+class SimBus : public TFMPBus
+{
+  public:
+    SimBus() : now( SIM_START)
+    {
+      memset( dev, 0, sizeof( dev));
+    }
+
+    SimDevice *add( uint8_t addr)
+    {
+      for( uint8_t i = 0; i < SIM_DEVICES; i++)
+      {
+        if( dev[ i].addr == 0)
+        {
+          dev[ i].addr = addr;
+          return &dev[ i];
+        }
+      }
+      return NULL;
+    }
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len)
+    {
+      now += SIM_TRANSFER;
+      SimDevice *d = find( addr);
+      if( d == NULL) return TFMP_BUS_NACK_ADDR;
+      if( int32_t( now - d->bootUntil) < 0)
+      {
+        if( !d->ackBoot) return TFMP_BUS_NACK_ADDR;
+        if( len >= 3 && data[ 2] == 0x00)
+        {
+          if( d->staleBoot) load( d, d->last, TFMP_FRAME_SIZE);
+            else d->pendingLen = 0;
+        }
+        return TFMP_BUS_OK;
+      }
+      if( len < 3) return TFMP_BUS_OK;
+      if( data[ 2] == 0x00)          // frame request
+      {
+        uint8_t f[ TFMP_FRAME_SIZE] = { 0x59, 0x59, 100, 0, 0xF4, 0x01, 0x08, 0x09, 0 };
+        if( d->period)
+        {
+          uint32_t n = now / d->period;
+          f[ 2] = uint8_t( n);
+          f[ 3] = uint8_t( ( n >> 8) & 0x0F);
+          d->frameTime = n * d->period;
+        }
+        load( d, f, TFMP_FRAME_SIZE);
+        memcpy( d->last, f, TFMP_FRAME_SIZE);
+      }
+      else if( data[ 2] == 0x02)     // soft reset
+      {
+        uint8_t r[ 5] = { 0x5A, 0x05, 0x02, 0x00, 0 };
+        if( d->dropReply) d->pendingLen = 0;
+          else load( d, r, 5);
+        d->bootUntil = now + d->bootMicros;
+      }
+      return TFMP_BUS_OK;
+    }
+
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len)
+    {
+      now += SIM_TRANSFER;
+      SimDevice *d = find( addr);
+      if( d == NULL) return 0;
+      if( int32_t( now - d->bootUntil) < 0 && !d->ackBoot) return 0;
+      // With nothing to send, a device answers with zeros.
+      if( d->pendingLen == 0)
+      {
+        memset( data, 0, len);
+        return len;
+      }
+      uint8_t count = ( len < d->pendingLen) ? len : d->pendingLen;
+      memcpy( data, d->pending, count);
+      d->pendingLen = 0;
+      return count;
+    }
+
+    uint32_t getMicros() { return now; }
+    void wait( uint32_t ms) { now += ms * 1000UL; }
+
+    uint32_t now;
+
+  private:
+    SimDevice dev[ SIM_DEVICES];
+
+    SimDevice *find( uint8_t addr)
+    {
+      for( uint8_t i = 0; i < SIM_DEVICES; i++)
+      {
+        if( dev[ i].addr == addr) return &dev[ i];
+      }
+      return NULL;
+    }
+
+    // Queue a frame or reply with its checksum.
+    static void load( SimDevice *d, uint8_t *data, uint8_t len)
+    {
+      data[ len - 1] = 0;
+      for( uint8_t i = 0; i < len - 1; i++) data[ len - 1] += data[ i];
+      memcpy( d->pending, data, len);
+      d->pendingLen = len;
+    }
+};
+//
+// - - - - - - - - - - -  End of Simulated Devices  - - - - - - - - - -
+
+
+// = = = = = = = = = = = = = =  CHECKS  = = = = = = = = = = = = = = =
+//
+static int failed = 0;
+
+static void check( bool passed, const char *name)
+{
+    printf( "%s  %s\n", passed ? "PASS" : "FAIL", name);
+    if( !passed) ++failed;
+}
+
+// A device that loses its reply to SOFT_RESET is still found ready
+// as soon as it sends frames, not left to time out.
+static void resetLostReply()
+{
+    SimBus bus;
+    TFMPI2C tfm( bus);
+    bus.add( 0x10)->bootMicros = 300000UL;
+    SimDevice *lost = bus.add( 0x11);
+    lost->bootMicros = 300000UL;
+    lost->dropReply = true;
+
+    uint8_t addr[ 2] = { 0x10, 0x11 }, result[ 2];
+    uint8_t ready = tfm.resetAll( addr, 2, result);
+    check( ready == 2 && result[ 0] == TFMP_READY && result[ 1] == TFMP_READY &&
+           bus.now - SIM_START < 400000UL, "resetAll() with a lost reply");
+}
+
+// A device that still acknowledges after SOFT_RESET, answering with
+// zeros or with its last frame, is not ready until it has started.
+static void resetAckBoot()
+{
+    SimBus bus;
+    TFMPI2C tfm( bus);
+    SimDevice *zeros = bus.add( 0x10);
+    zeros->bootMicros = 300000UL;
+    zeros->ackBoot = true;
+    SimDevice *stale = bus.add( 0x11);
+    stale->bootMicros = 80000UL;
+    stale->ackBoot = true;
+    stale->staleBoot = true;
+    stale->dropReply = true;
+
+    // Give the stale device a last frame to repeat.
+    TFMPSample s;
+    tfm.getData( s, 0x11);
+
+    uint8_t addr[ 2] = { 0x10, 0x11 }, result[ 2];
+    uint8_t ready = tfm.resetAll( addr, 2, result);
+    check( ready == 2 && result[ 0] == TFMP_READY && result[ 1] == TFMP_READY &&
+           int32_t( bus.now - zeros->bootUntil) >= 0 &&
+           int32_t( bus.now - stale->bootUntil) >= 0 &&
+           bus.now - SIM_START < 400000UL, "resetAll() with a device that acknowledges");
+}
+
+// Reads locked to a device whose clock runs slow or fast are still
+// made just after each frame lands, and no old frame counts as new.
+static void phaseDrift()
+{
+    const int32_t ppm[ 5] = { 100, 200, 1000, -1000, -5000 };
+    bool passed = true;
+    for( uint8_t k = 0; k < 5; k++)
+    {
+      SimBus bus;
+      TFMPI2C tfm( bus);
+      SimDevice *d = bus.add( 0x10);
+      d->period = uint32_t( 10000 + 10000L * ppm[ k] / 1000000L);
+      TFMPPhase phase( 100);
+      TFMPSample s;
+      uint32_t newCount = 0, lastFrame = 0xFFFFFFFFUL, stale = 0;
+      uint64_t trueAge = 0, age = 0;
+      while( bus.now - SIM_START < 30000000UL)
+      {
+        if( !phase.due( bus.now))
+        {
+          bus.now = phase.nextPoll;
+          continue;
+        }
+        tfm.getData( s, 0x10);
+        if( !phase.update( s)) continue;
+        // No old frame may count as new.  Once the first five
+        // seconds have passed, the age of every frame is checked.
+        if( d->frameTime == lastFrame) ++stale;
+        lastFrame = d->frameTime;
+        if( s.time - SIM_START < 5000000UL) continue;
+        ++newCount;
+        trueAge += s.time + SIM_TRANSFER - d->frameTime;
+        age += phase.age;
+      }
+      uint32_t meanTrue = uint32_t( trueAge / newCount);
+      uint32_t meanAge = uint32_t( age / newCount);
+      int32_t err = phase.drift() - ppm[ k];
+      if( stale || meanTrue > 200 || meanAge > meanTrue + 100 ||
+          meanTrue > meanAge + 100 || err > 50 || err < -50) passed = false;
+    }
+    check( passed, "phase lock on a drifting device");
+}
+
+// A device at a stored address that is slow to start is warm started
+// once it answers.  If it never answers, the address is kept.
+static void warmStartSlow()
+{
+    SimBus bus;
+    TFMPI2C tfm( bus);
+    bus.add( 0x11)->bootUntil = SIM_START + 300000UL;
+    TFMPConfig cfg( FRAME_100, TFMP_FORMAT_CM, true, 0x11);
+    TFMPState state;
+    state.addr = 0x11;
+    state.frameRate = FRAME_100;
+    state.format = TFMP_FORMAT_CM;
+    state.output = 1;
+    state.version[ 0] = 2;
+    state.configHash = cfg.hash();
+    TFMPState stored = state;
+
+    bool passed = cfg.warmStart( tfm, state) && cfg.sent == 0 &&
+                  bus.now - SIM_START >= 300000UL && state.configHash == cfg.hash();
+
+    SimBus empty;
+    tfm.setBus( empty);
+    state = stored;
+    passed = passed && !cfg.warmStart( tfm, state) && state.addr == 0x11 &&
+             state.version[ 0] == 2 && state.configHash == 0;
+    check( passed, "warmStart() with a slow device");
+}
+
+// Three days of intervals at 1 kHz still give the right mean and
+// deviation, and bins at 1 Hz are one eighth of the period.
+static void jitterLong()
+{
+    TFMPJitter j( 1000);
+    uint32_t t = 0;
+    j.update( t);
+    for( uint32_t i = 0; i < 260000000UL; i++)
+    {
+      t += ( i & 1) ? 1010 : 990;
+      j.update( t);
+    }
+    TFMPJitter slow( 1);
+    check( j.mean() == 1000 && j.stdDev() == 10 && slow.binWidth == 125000UL,
+           "jitter statistics over three days");
+}
+
+// The millimeter format belongs to each object, or with TFMP_COMPACT
+// to every object, and a single object keeps one for each address.
+static void formatShared()
+{
+    SimBus bus, bus1;
+    TFMPI2C tfm( bus), tfm1( bus1);
+    tfm.setFormat( TFMP_FORMAT_MM, 0x10);
+    bool passed = tfm.getFormat( 0x10) == TFMP_FORMAT_MM &&
+                  tfm.getFormat( 0x11) == TFMP_FORMAT_CM;
+  #if defined( TFMP_COMPACT)
+    passed = passed && tfm1.getFormat( 0x10) == TFMP_FORMAT_MM;
+  #else
+    passed = passed && tfm1.getFormat( 0x10) == TFMP_FORMAT_CM;
+  #endif
+    tfm.setFormat( TFMP_FORMAT_CM, 0x10);
+    check( passed && tfm1.getFormat( 0x10) == TFMP_FORMAT_CM, "millimeter format by address");
+}
+
+// The new frame rate falls to zero when a device stops sending new
+// frames but is still read, whether the reads fail or repeat a frame.
+// Only with triggered frames is every match a repeat.
+static void duplicateRate()
+{
+    bool passed = true;
+    for( uint8_t k = 0; k < 2; k++)
+    {
+      TFMPDuplicate dup( k ? 0 : 100);
+      TFMPSample s;
+      memset( &s, 0, sizeof( s));
+      for( uint16_t i = 0; i < 800; i++)   // read at 200 Hz for 4 seconds
+      {
+        s.time = i * 5000UL;
+        s.flags = 0;
+        if( i < 400) s.dist = i / 2;        // new frames for 2 seconds
+          else if( k == 0) s.status = TFMP_I2CREAD;
+        dup.check( s);
+        if( i == 399 && ( dup.rate < 99 || dup.rate > 101)) passed = false;
+      }
+      if( dup.rate != 0) passed = false;
+    }
+    check( passed, "new frame rate of a stopped device");
+}
+
+// Each of a sensor's own callbacks is given the context set with it.
+// A compact build has no callbacks for one sensor.
+#if !defined( TFMP_COMPACT)
+static void *calledWith[ 3];
+
+static void onSample( uint8_t, const TFMPSample &, void *context) { calledWith[ 0] = context; }
+static void onError( uint8_t, const TFMPSample &, void *context) { calledWith[ 1] = context; }
+static void onChange( uint8_t, const TFMPSample &, void *context) { calledWith[ 2] = context; }
+#endif
+
+static void callbackContexts()
+{
+  #if !defined( TFMP_COMPACT)
+    SimBus bus;
+    TFMPI2C tfm( bus);
+    SimDevice *d = bus.add( 0x10);
+    TFMPScheduler sched;
+    int8_t i = sched.add( 0x10, 100);
+    int contexts[ 3];
+    sched.onSample( i, onSample, &contexts[ 0]);
+    sched.onError( i, onError, &contexts[ 1]);
+    sched.onStatusChange( i, onChange, &contexts[ 2]);
+    sched.begin( bus.now);
+
+    sched.poll( tfm);               // a good frame
+    d->bootUntil = bus.now + 1000000UL;
+    bus.wait( 10);
+    sched.poll( tfm);               // no answer, so an error and a change
+    check( calledWith[ 0] == &contexts[ 0] && calledWith[ 1] == &contexts[ 1] &&
+           calledWith[ 2] == &contexts[ 2], "scheduler callback contexts");
+  #endif
+}
+
+// A replayed session stamps every sample with the same time as the
+// live session that was recorded.
+static void replayTimes()
+{
+    const uint8_t samples = 5;
+    uint32_t live[ samples], replayed[ samples];
+    FILE *f = tmpfile();
+
+    SimBus bus;
+    bus.add( 0x10);
+    TFMPRecordBus record( bus, f);
+    record.begin();
+    TFMPI2C tfm( record);
+    TFMPSample s;
+    for( uint8_t i = 0; i < samples; i++)
+    {
+      tfm.getData( s);
+      live[ i] = s.time;
+      bus.wait( 1);
+    }
+
+    rewind( f);
+    TFMPReplayBus replay( f);
+    bool passed = replay.begin();
+    tfm.setBus( replay);
+    for( uint8_t i = 0; i < samples; i++)
+    {
+      tfm.getData( s);
+      replayed[ i] = s.time;
+      if( replayed[ i] != live[ i]) passed = false;
+    }
+    fclose( f);
+    check( passed && replay.mismatches == 0, "replayed sample times");
+}
+
+// A recording that ends while the library waits for a reply
+// still lets the wait time out.
+static void replayEnded()
+{
+    FILE *f = tmpfile();
+    SimBus bus;
+    bus.add( 0x10);
+    TFMPRecordBus record( bus, f);
+    record.begin();
+    TFMPI2C tfm( record);
+    // Only the first half of `discover()`: the probe and the request.
+    record.write( 0x10, NULL, 0);
+    tfm.sendRequest( GET_FIRMWARE_VERSION, 0, 0x10);
+
+    rewind( f);
+    TFMPReplayBus replay( f);
+    bool passed = replay.begin();
+    tfm.setBus( replay);
+    TFMPDevice list[ 1];
+    passed = passed && tfm.discover( list, 1, 0x10, 0x10) == 0 &&
+             tfm.status == TFMP_TIMEOUT && replay.done();
+    fclose( f);
+    check( passed, "replay past the end of a recording");
+}
+
+// A binary log with a lost byte decodes only true records
+// and takes up both sensors again at their next keyframes.
+static void binLogResync()
+{
+    const uint8_t addr[ 2] = { 0x10, 0x11};
+    TFMPBinLogWriter log( 4);
+    uint8_t data[ 2048];
+    size_t len = log.header( 2, addr, NULL);
+    memcpy( data, log.buf, len);
+    TFMPBinLogRecord sent[ 80];
+    size_t lost = 0;
+    for( uint8_t i = 0; i < 80; i++)
+    {
+      TFMPBinLogRecord &r = sent[ i];
+      r.sensor = i & 1;
+      r.time = SIM_START + i * 5000UL;
+      r.dist = int16_t( 100 + ( i * 37) % 300);
+      r.flux = int16_t( 2000 - i * 11);
+      r.temp = int16_t( 2500 + i);
+      r.status = ( i % 9 == 0) ? TFMP_WEAK : 0;
+      if( i == 20) lost = len + 3;   // inside a record
+      uint8_t n = log.record( r.sensor, r.time, r.dist, r.flux, r.temp, r.status);
+      memcpy( &data[ len], log.buf, n);
+      len += n;
+    }
+    memmove( &data[ lost], &data[ lost + 1], len - lost - 1);
+    --len;
+
+    TFMPBinLogReader read;
+    size_t pos = read.readHeader( data, len);
+    bool passed = ( pos != 0);
+    unsigned good = 0, after = 0;
+    while( passed && pos < len)
+    {
+      TFMPBinLogRecord rec;
+      size_t used = read.readRecord( &data[ pos], len - pos, rec);
+      if( read.status == TFMP_BINLOG_OK)
+      {
+        bool found = false;
+        for( uint8_t i = 0; i < 80; i++)
+        {
+          const TFMPBinLogRecord &r = sent[ i];
+          found = found || ( r.sensor == rec.sensor && r.time == rec.time &&
+                  r.dist == rec.dist && r.flux == rec.flux &&
+                  r.temp == rec.temp && r.status == rec.status);
+        }
+        passed = found;
+        ++good;
+        if( pos > lost) ++after;
+      }
+      else if( read.status == TFMP_BINLOG_SHORT) break;
+      else if( read.status != TFMP_BINLOG_NOKEY) used = 1;
+      pos += used;
+    }
+    // Any other format version is refused.
+    TFMPBinLogReader other;
+    data[ 4] = TFMP_BINLOG_VERSION + 1;
+    passed = passed && after >= 50 && good < 80 &&
+             other.readHeader( data, len) == 0 &&
+             other.status == TFMP_BINLOG_VERSION_ERR;
+    check( passed, "binary log after a lost byte");
+}
+
+// Sensors wanted at unrelated rates are planned so that no two reads
+// ever overlap, and a bus too slow for even one read a second each is
+// reported as overloaded.
+static void plannerSlots()
+{
+    TFMPPlanner planner( 400000UL);
+    const uint16_t wanted[ 4] = { 100, 30, 7, 45};
+    for( uint8_t i = 0; i < 4; i++) planner.add( 0x10 + i, wanted[ i]);
+    bool passed = planner.plan() && !planner.overloaded &&
+                  planner.utilization <= 90;
+
+    // Every read start over two major cycles, and the shortest time
+    // between two of them.
+    uint32_t read = planner.readMicros();
+    uint32_t major = 32 * planner.period( 0);
+    uint32_t gap = major;
+    for( uint8_t i = 0; i < 4; i++)
+    {
+      passed = passed && planner.feasible( i);
+      for( uint32_t t = planner.offset( i); t < 2 * major; t += planner.period( i))
+      {
+        for( uint8_t j = 0; j < 4; j++)
+        {
+          if( j == i) continue;
+          for( uint32_t u = planner.offset( j); u < 2 * major; u += planner.period( j))
+          {
+            uint32_t d = ( t > u) ? t - u : u - t;
+            if( d < gap) gap = d;
+          }
+        }
+      }
+    }
+    passed = passed && gap >= read;
+
+    TFMPPlanner slow( 10000UL, TFMP_PLAN_OVERHEAD, 1);
+    for( uint8_t i = 0; i < 8; i++) slow.add( 0x10 + i, 10);
+    passed = passed && !slow.plan() && slow.overloaded &&
+             slow.utilization > 1;
+    check( passed, "planned reads never overlap");
+}
+
+static uint8_t warnings;
+static bool warnedLast;
+static void onTTCWarning( const TFMPTTC &ttc, const TFMPSample &, void *)
+{
+    ++warnings;
+    warnedLast = ttc.warning;
+}
+
+// A time-to-contact warning that is cleared by a gap in the samples
+// calls back just as one cleared by the target moving away does.
+static void ttcGap()
+{
+    TFMPTTC ttc;
+    ttc.onWarning( 200, onTTCWarning);
+    TFMPSample s = TFMPSample();
+    s.time = SIM_START;
+    // Closing at 10 meters a second from 3 meters, 1000 frames a second
+    for( int16_t i = 0; i < 200; i++)
+    {
+      s.dist = int16_t( 300 - i);
+      ttc.update( s);
+      s.time += 1000;
+    }
+    bool passed = ( warnings == 1 && warnedLast);
+    s.time += TFMP_TTC_GAP + 1000;
+    ttc.update( s);
+    check( passed && warnings == 2 && !warnedLast && !ttc.warning,
+           "time-to-contact warning cleared by a gap");
+}
+
+// An output period with no good frame passes back zeros,
+// not whatever was in the sample before.
+static void oversampleEmpty()
+{
+    SimBus bus;
+    TFMPI2C tfm( bus);
+    TFMPOversample over( tfm, 0x10);
+    over.begin( FRAME_100, 10);
+    TFMPSample s;
+    s.dist = 1234;
+    s.flux = 5678;
+    s.temp = 99;
+    bool ready = false;
+    for( uint16_t i = 0; i < 1000 && !ready; i++)
+    {
+      ready = over.update( s);
+      bus.wait( 1);
+    }
+    check( ready && s.count == 0 && s.status != TFMP_READY &&
+           s.dist == 0 && s.flux == 0 && s.temp == 0,
+           "oversample with no good frame");
+}
+//
+// - - - - - - - - - - - - - -  End of Checks  - - - - - - - - - - - - -
+
+int main()
+{
+    resetLostReply();
+    resetAckBoot();
+    phaseDrift();
+    warmStartSlow();
+    jitterLong();
+    formatShared();
+    duplicateRate();
+    callbackContexts();
+    replayTimes();
+    replayEnded();
+    binLogResync();
+    plannerSlots();
+    ttcGap();
+    oversampleEmpty();
+    printf( "%d failed\n", failed);
+    return failed;
+}
@@ -0,0 +1,307 @@
+/* File Name: TFMPBinLog.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Compact binary sample log for the TFMPI2C library.
+ *            See `TFMPBinLog.h` for a description of the format.
+ *
+ *  Numbers are written as 'varints': seven bits per byte, low order
+ *  bits first, with bit 7 set on every byte but the last.  Signed
+ *  values are first 'zigzag' encoded (0, -1, 1, -2, 2... becomes
+ *  0, 1, 2, 3, 4...) so that small negative differences stay short.
+ */
+
+#include "TFMPBinLog.h"
+#include <string.h>
+
+// - - - - - - - - -  Varint helper functions  - - - - - - - - - -
+//
+static uint8_t putVarint( uint8_t *p, uint32_t v)
+{
+    uint8_t n = 0;
+    while( v >= 0x80)
+    {
+      p[ n++] = uint8_t( v) | 0x80;
+      v >>= 7;
+    }
+    p[ n++] = uint8_t( v);
+    return n;
+}
+
+static uint32_t zigzag( int32_t v)
+{
+    return ( uint32_t( v) << 1) ^ uint32_t( v >> 31);
+}
+
+static int32_t unzigzag( uint32_t v)
+{
+    return int32_t( v >> 1) ^ -int32_t( v & 1);
+}
+
+#define VARINT_BAD   0xFF    // getVarint() found more than five bytes
+
+// Read a varint of at most five bytes.  Returns the number of bytes
+// used, zero if the data is short, or VARINT_BAD if the fifth byte
+// still says that more follow.
+static uint8_t getVarint( const uint8_t *p, size_t len, uint32_t &v)
+{
+    v = 0;
+    for( uint8_t i = 0; i < 5 && i < len; i++)
+    {
+      v |= uint32_t( p[ i] & 0x7F) << ( 7 * i);
+      if( ( p[ i] & 0x80) == 0) return i + 1;
+    }
+    return ( len >= 5) ? VARINT_BAD : 0;
+}
+
+// CRC-8 with polynomial 0x07, bit by bit, so no table is needed.
+static uint8_t crc8( const uint8_t *p, size_t len)
+{
+    uint8_t crc = 0;
+    for( size_t i = 0; i < len; i++)
+    {
+      crc ^= p[ i];
+      for( uint8_t b = 0; b < 8; b++)
+      {
+        crc = ( crc & 0x80) ? uint8_t( ( crc << 1) ^ 0x07) : uint8_t( crc << 1);
+      }
+    }
+    return crc;
+}
+//
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// = = = = = = = = = = = =  LOG WRITER  = = = = = = = = = = = = = =
+//
+TFMPBinLogWriter::TFMPBinLogWriter( uint8_t interval)
+  : keyInterval( interval ? interval : 1), sensors( 0), lastTime( 0)
+{
+    memset( track, 0, sizeof( track));
+}
+
+uint8_t TFMPBinLogWriter::header( uint8_t count, const uint8_t addr[], const uint8_t units[])
+{
+    if( count == 0 || count > TFMP_BINLOG_MAX_SENSORS) return 0;
+    sensors = count;
+    keyframe();
+
+    buf[ 0] = 'T';
+    buf[ 1] = 'F';
+    buf[ 2] = 'M';
+    buf[ 3] = 'B';
+    buf[ 4] = TFMP_BINLOG_VERSION;
+    buf[ 5] = 0;               // time unit is microseconds
+    buf[ 6] = keyInterval;
+    buf[ 7] = count;
+    uint8_t n = TFMP_BINLOG_HEAD_SIZE;
+    for( uint8_t i = 0; i < count; i++)
+    {
+      buf[ n++] = addr[ i];
+      buf[ n++] = units ? units[ i] : TFMP_BINLOG_CM;
+    }
+    return n;
+}
+
+uint8_t TFMPBinLogWriter::record( uint8_t sensor, uint32_t time,
+                int16_t dist, int16_t flux, int16_t temp, uint8_t status)
+{
+    if( sensor >= sensors) return 0;
+    TFMPBinLogTrack &t = track[ sensor];
+
+    uint8_t n = 1;
+    buf[ 0] = sensor;
+    if( t.count == 0)          // If a keyframe is due...
+    {                          // send absolute values.
+      buf[ 0] |= TFMP_BINLOG_KEY;
+      n += putVarint( &buf[ n], time);
+      n += putVarint( &buf[ n], zigzag( dist));
+      n += putVarint( &buf[ n], zigzag( flux));
+      n += putVarint( &buf[ n], zigzag( temp));
+      t.count = keyInterval;
+    }
+    else                       // Otherwise send differences.
+    {
+      n += putVarint( &buf[ n], time - lastTime);
+      n += putVarint( &buf[ n], zigzag( int32_t( dist) - t.dist));
+      n += putVarint( &buf[ n], zigzag( int32_t( flux) - t.flux));
+      n += putVarint( &buf[ n], zigzag( int32_t( temp) - t.temp));
+    }
+    --t.count;
+
+    if( status != 0)           // Status is only sent if not READY.
+    {
+      buf[ 0] |= TFMP_BINLOG_STATUS;
+      buf[ n++] = status;
+    }
+    // Every record ends with a check byte, so that a reader
+    // can tell a lost or wrong byte and find the stream again.
+    uint8_t check = crc8( buf, n);
+    buf[ n++] = check;
+
+    lastTime = time;
+    t.time = time;
+    t.dist = dist;
+    t.flux = flux;
+    t.temp = temp;
+    return n;
+}
+
+void TFMPBinLogWriter::keyframe()
+{
+    for( uint8_t i = 0; i < TFMP_BINLOG_MAX_SENSORS; i++) track[ i].count = 0;
+}
+//
+// - - - - - - - - - - - -  End of Log Writer  - - - - - - - - - - -
+
+
+// = = = = = = = = = = = =  LOG READER  = = = = = = = = = = = = = =
+//
+TFMPBinLogReader::TFMPBinLogReader()
+  : status( TFMP_BINLOG_SHORT), version( 0), keyInterval( 0),
+    sensors( 0), lastTime( 0)
+{
+    memset( addr, 0, sizeof( addr));
+    memset( units, 0, sizeof( units));
+    memset( haveKey, 0, sizeof( haveKey));
+    memset( track, 0, sizeof( track));
+}
+
+size_t TFMPBinLogReader::readHeader( const uint8_t *data, size_t len)
+{
+    if( len < TFMP_BINLOG_HEAD_SIZE)
+    {
+      status = TFMP_BINLOG_SHORT;
+      return 0;
+    }
+    if( memcmp( data, "TFMB", 4) != 0 ||
+        data[ 7] == 0 || data[ 7] > 16)
+    {
+      status = TFMP_BINLOG_MAGIC;
+      return 0;
+    }
+    if( data[ 4] != TFMP_BINLOG_VERSION)
+    {
+      status = TFMP_BINLOG_VERSION_ERR;
+      return 0;
+    }
+    size_t n = TFMP_BINLOG_HEAD_SIZE + 2 * size_t( data[ 7]);
+    if( len < n)
+    {
+      status = TFMP_BINLOG_SHORT;
+      return 0;
+    }
+
+    version = data[ 4];
+    keyInterval = data[ 6];
+    sensors = data[ 7];
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      addr[ i]  = data[ TFMP_BINLOG_HEAD_SIZE + 2 * i];
+      units[ i] = data[ TFMP_BINLOG_HEAD_SIZE + 2 * i + 1];
+      haveKey[ i] = false;
+    }
+    status = TFMP_BINLOG_OK;
+    return n;
+}
+
+size_t TFMPBinLogReader::readRecord( const uint8_t *data, size_t len, TFMPBinLogRecord &rec)
+{
+    if( len < 1)
+    {
+      status = TFMP_BINLOG_SHORT;
+      return 0;
+    }
+    uint8_t tag = data[ 0];
+    uint8_t sensor = tag & TFMP_BINLOG_INDEX;
+    if( sensor >= sensors)
+    {
+      lostTrack();
+      status = TFMP_BINLOG_INDEX_ERR;
+      return 0;
+    }
+
+    // Decode the four numbers that follow the tag.
+    uint32_t v[ 4];
+    size_t n = 1;
+    for( uint8_t i = 0; i < 4; i++)
+    {
+      uint8_t used = getVarint( &data[ n], len - n, v[ i]);
+      if( used == 0)
+      {
+        status = TFMP_BINLOG_SHORT;
+        return 0;
+      }
+      if( used == VARINT_BAD)
+      {
+        lostTrack();
+        status = TFMP_BINLOG_BAD;
+        return 0;
+      }
+      n += used;
+    }
+    rec.status = 0;
+    if( tag & TFMP_BINLOG_STATUS)
+    {
+      if( n >= len)
+      {
+        status = TFMP_BINLOG_SHORT;
+        return 0;
+      }
+      rec.status = data[ n++];
+    }
+    if( n >= len)
+    {
+      status = TFMP_BINLOG_SHORT;
+      return 0;
+    }
+    if( data[ n] != crc8( data, n))
+    {
+      lostTrack();
+      status = TFMP_BINLOG_BAD;
+      return 0;
+    }
+    ++n;
+
+    TFMPBinLogTrack &t = track[ sensor];
+    rec.sensor = sensor;
+    rec.keyframe = ( tag & TFMP_BINLOG_KEY) != 0;
+    if( rec.keyframe)
+    {
+      rec.time = v[ 0];
+      rec.dist = int16_t( unzigzag( v[ 1]));
+      rec.flux = int16_t( unzigzag( v[ 2]));
+      rec.temp = int16_t( unzigzag( v[ 3]));
+      haveKey[ sensor] = true;
+    }
+    else
+    {
+      if( !haveKey[ sensor])
+      {
+        lastTime += v[ 0];     // Keep time for the other sensors
+        status = TFMP_BINLOG_NOKEY;
+        return n;              // and skip the whole record.
+      }
+      rec.time = lastTime + v[ 0];
+      rec.dist = int16_t( t.dist + unzigzag( v[ 1]));
+      rec.flux = int16_t( t.flux + unzigzag( v[ 2]));
+      rec.temp = int16_t( t.temp + unzigzag( v[ 3]));
+    }
+
+    lastTime = rec.time;
+    t.time = rec.time;
+    t.dist = rec.dist;
+    t.flux = rec.flux;
+    t.temp = rec.temp;
+    status = TFMP_BINLOG_OK;
+    return n;
+}
+
+// The stream is out of step, so no last values can be trusted
+// until each sensor's next good keyframe.
+void TFMPBinLogReader::lostTrack()
+{
+    memset( haveKey, 0, sizeof( haveKey));
+}
+//
+// - - - - - - - - - - - -  End of Log Reader  - - - - - - - - - - -
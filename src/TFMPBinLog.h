@@ -0,0 +1,168 @@
+/* File Name: TFMPBinLog.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Compact binary sample log for the TFMPI2C library.
+ *
+ *  Printing every frame as text saturates a serial port or an SD card
+ *  long before the sensors run out of frames.  This file defines a small
+ *  binary record format that can log every frame from several sensors
+ *  at full rate.
+ *
+ *  'TFMPBinLogWriter' runs on the Arduino.  It encodes one header or one
+ *  record at a time into its own small fixed buffer `buf` and returns the
+ *  number of bytes to send, i.e. `Serial.write( log.buf, len)`.
+ *
+ *  'TFMPBinLogReader' runs on the host.  It uses no Arduino functions and
+ *  decodes the same stream back into header and sample records.
+ *
+ *  Log format:
+ *    Header - written once at the beginning of the log
+ *      Byte0-3  'T' 'F' 'M' 'B'   magic characters
+ *      Byte4    format version (2)
+ *      Byte5    time unit (0 = microseconds)
+ *      Byte6    keyframe interval
+ *      Byte7    sensor count (n)
+ *      then n pairs of:  I2C address, distance units (0 = cm, 1 = mm)
+ *
+ *    Record - one for every frame of data
+ *      Tag      bit 7 = keyframe, bit 6 = status byte follows,
+ *               bits 0-3 = sensor index
+ *      Time     unsigned varint: absolute in a keyframe,
+ *               otherwise the time elapsed since the last record
+ *      Dist     zigzag varint: absolute in a keyframe,
+ *      Flux       "            otherwise the difference from
+ *      Temp       "            the last record of the same sensor
+ *      Status   only if tag bit 6 is set, a library status code
+ *      Check    CRC-8 (polynomial 0x07) of the bytes above
+ *
+ *  A keyframe is written for each sensor every 'keyframe interval'
+ *  records so that a reader can pick up the stream after a lost byte.
+ *  After any record that cannot be decoded or has a wrong check byte,
+ *  the reader forgets every sensor's last values.  It takes up each
+ *  sensor again only at that sensor's next good keyframe, and skips
+ *  its delta records until then.
+ *  A typical delta record is 5 or 6 bytes, against 9 for a raw frame
+ *  or about 40 for a line of text.
+ */
+
+#ifndef TFMPBINLOG_H       // Guard to compile only once
+#define TFMPBINLOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Maximum number of sensors in one log.
+// The tag byte allows at most 16.
+#ifndef TFMP_BINLOG_MAX_SENSORS
+#define TFMP_BINLOG_MAX_SENSORS   4
+#endif
+
+#define TFMP_BINLOG_VERSION       2
+#define TFMP_BINLOG_HEAD_SIZE     8    // header size without sensor list
+#define TFMP_BINLOG_REC_MAX      17    // longest possible record
+
+// Writer buffer must hold either a complete header or a complete record.
+#define TFMP_BINLOG_BUF_SIZE \
+    ( ( TFMP_BINLOG_HEAD_SIZE + 2 * TFMP_BINLOG_MAX_SENSORS) > TFMP_BINLOG_REC_MAX ? \
+      ( TFMP_BINLOG_HEAD_SIZE + 2 * TFMP_BINLOG_MAX_SENSORS) : TFMP_BINLOG_REC_MAX)
+
+// Record tag bits
+#define TFMP_BINLOG_KEY        0x80
+#define TFMP_BINLOG_STATUS     0x40
+#define TFMP_BINLOG_INDEX      0x0F
+
+// Distance unit codes used in the header
+#define TFMP_BINLOG_CM            0
+#define TFMP_BINLOG_MM            1
+
+// Reader status codes
+#define TFMP_BINLOG_OK            0    // header or record decoded
+#define TFMP_BINLOG_SHORT         1    // more data needed
+#define TFMP_BINLOG_MAGIC         2    // header not recognized
+#define TFMP_BINLOG_INDEX_ERR     3    // sensor index out of range
+#define TFMP_BINLOG_NOKEY         4    // delta record before a keyframe
+#define TFMP_BINLOG_BAD           5    // record not valid, i.e. a varint too long
+                                       // or a check byte that is wrong
+#define TFMP_BINLOG_VERSION_ERR   6    // header format version not supported
+
+// One decoded sample record
+struct TFMPBinLogRecord
+{
+    uint8_t  sensor;     // sensor index in the header list
+    bool     keyframe;   // record was a keyframe
+    uint32_t time;       // timestamp in microseconds
+    int16_t  dist;
+    int16_t  flux;
+    int16_t  temp;
+    uint8_t  status;     // library status code, TFMP_READY = 0
+};
+
+// Last values sent or received for one sensor
+struct TFMPBinLogTrack
+{
+    uint32_t time;
+    int16_t  dist;
+    int16_t  flux;
+    int16_t  temp;
+    uint8_t  count;      // records left until next keyframe
+};
+
+class TFMPBinLogWriter
+{
+  public:
+    TFMPBinLogWriter( uint8_t interval = 32);
+
+    uint8_t buf[ TFMP_BINLOG_BUF_SIZE];   // encoded output
+
+    // Encode a header for `count` sensors.  Returns the number
+    // of bytes in `buf` or zero if `count` is out of range.
+    // A sensor set to millimeters with `setFormat()` should be
+    // given TFMP_BINLOG_MM units.  `units` may be NULL for all cm.
+    uint8_t header( uint8_t count, const uint8_t addr[], const uint8_t units[]);
+    // Encode one record.  Returns the number of bytes in `buf`
+    // or zero if `sensor` is out of range.
+    uint8_t record( uint8_t sensor, uint32_t time,
+                    int16_t dist, int16_t flux, int16_t temp, uint8_t status);
+    // Force the next record of every sensor to be a keyframe.
+    void keyframe();
+
+  private:
+    uint8_t keyInterval;
+    uint8_t sensors;
+    uint32_t lastTime;   // time of the last record of any sensor
+    TFMPBinLogTrack track[ TFMP_BINLOG_MAX_SENSORS];
+};
+
+class TFMPBinLogReader
+{
+  public:
+    TFMPBinLogReader();
+
+    uint8_t status;              // result of the last read: BINLOG_OK = 0
+    uint8_t version;             // header format version
+    uint8_t keyInterval;
+    uint8_t sensors;             // sensor count from the header
+    uint8_t addr[ 16];           // I2C address of each sensor
+    uint8_t units[ 16];          // distance units of each sensor
+
+    // Decode the header.  Returns the number of bytes used,
+    // or zero and sets `status` if incomplete or not valid.
+    size_t readHeader( const uint8_t *data, size_t len);
+    // Decode one record.  Returns the number of bytes used,
+    // or zero and sets `status` if incomplete or not valid.
+    // After an error, skip one byte and try again.  A delta
+    // record that comes before its keyframe is skipped, and
+    // `status` is set to NOKEY.  SHORT is not an error: call
+    // again at the same place once more data has come in.
+    size_t readRecord( const uint8_t *data, size_t len, TFMPBinLogRecord &rec);
+
+  private:
+    uint32_t lastTime;
+    bool     haveKey[ 16];
+    TFMPBinLogTrack track[ 16];
+
+    void lostTrack();
+};
+
+#endif
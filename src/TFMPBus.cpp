@@ -0,0 +1,44 @@
+/* File Name: TFMPBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Arduino Wire bus for the TFMPI2C library.
+ *            See `TFMPBus.h` for a description.
+ */
+
+#include "TFMPBus.h"
+
+#if defined( ARDUINO)
+
+TFMPWireBus::TFMPWireBus( TwoWire &wire) : wire( wire) {}
+
+uint8_t TFMPWireBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    // Begin transmission to the I2C slave device
+    wire.beginTransmission( addr);
+    // Queue data array for transmission to the I2C device
+    if( wire.write( data, (size_t)len) != len)
+    {
+        wire.write( 0);             // Put a zero in the xmit buffer.
+        wire.endTransmission( true);   // Send and Close the I2C interface.
+        return TFMP_BUS_LENGTH;     // and return length error.
+    }
+    // Transmit the bytes and a stop message to release the I2C bus.
+    return wire.endTransmission( true);
+}
+
+uint8_t TFMPWireBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    // Request data from the slave device address
+    // and close the I2C interface.
+    wire.requestFrom( (int)addr, (int)len, 1);
+
+    uint8_t count = 0;
+    while( count < len && wire.peek() != -1)  // while there is a next byte...
+    {
+      data[ count++] = uint8_t( wire.read());
+    }
+    return count;
+}
+
+#endif
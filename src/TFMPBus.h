@@ -0,0 +1,93 @@
+/* File Name: TFMPBus.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: I2C bus interface for the TFMPI2C library.
+ *
+ *  Every I2C transfer made by `getData()` and `sendCommand()` goes
+ *  through a `TFMPBus` object.  By default that is `TFMPWireBus`,
+ *  which simply calls the Arduino Wire library.  Other buses can be
+ *  wrapped around it to record the bus traffic, or put in its place
+ *  to replay a recording on a host computer.
+ *
+ *  A bus also supplies the time base and the command reply delay,
+ *  so that a replayed session can run as fast as the CPU allows and
+ *  still see the same timestamps as the original.
+ *
+ *  A bus can also be locked by one thread while it makes a transfer
+ *  that must not be split, such as a frame request and its read.  On
+ *  an Arduino there is only one thread and `lock()` does nothing.  On
+ *  a host, `TFMPLockedBus` (see `TFMPLockedBus.h`) adds a real lock.
+ */
+
+#ifndef TFMPBUS_H       // Guard to compile only once
+#define TFMPBUS_H
+
+#if defined( ARDUINO)
+  #include <Arduino.h>
+  #include <Wire.h>
+#else
+  #include "TFMPHost.h"
+#endif
+
+// Bus `write()` return codes, the same as `Wire.endTransmission()`
+#define TFMP_BUS_OK          0  // success
+#define TFMP_BUS_LENGTH      1  // data too long for transmit buffer
+#define TFMP_BUS_NACK_ADDR   2  // address not acknowledged
+#define TFMP_BUS_NACK_DATA   3  // data not acknowledged
+#define TFMP_BUS_OTHER       4  // other error
+#define TFMP_BUS_TIMEOUT     5  // bus timeout
+
+class TFMPBus
+{
+  public:
+    virtual ~TFMPBus() {}
+
+    // Write `len` bytes to the device at `addr` and end with a STOP.
+    // Returns TFMP_BUS_OK or one of the error codes above.
+    virtual uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len) = 0;
+    // Read up to `len` bytes from the device at `addr` and end with
+    // a STOP.  Returns the number of bytes actually read.
+    virtual uint8_t read( uint8_t addr, uint8_t *data, uint8_t len) = 0;
+
+    // Time base in microseconds
+    virtual uint32_t getMicros() { return micros(); }
+    // Wait for a device to process a command
+    virtual void wait( uint32_t ms) { delay( ms); }
+
+    // Hold the bus for one thread.  A bus that can be
+    // shared between threads must allow nested locks.
+    virtual void lock() {}
+    virtual void unlock() {}
+};
+
+// Holds a bus lock until it goes out of scope.
+class TFMPBusLock
+{
+  public:
+    TFMPBusLock( TFMPBus &bus) : bus( bus) { bus.lock(); }
+    ~TFMPBusLock() { bus.unlock(); }
+
+  private:
+    TFMPBus &bus;
+    TFMPBusLock( const TFMPBusLock &);
+    TFMPBusLock &operator=( const TFMPBusLock &);
+};
+
+#if defined( ARDUINO)
+// Bus that uses an Arduino `TwoWire` interface,
+// normally `Wire`, or `Wire1` for a second port.
+class TFMPWireBus : public TFMPBus
+{
+  public:
+    TFMPWireBus( TwoWire &wire);
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+
+  private:
+    TwoWire &wire;
+};
+#endif
+
+#endif
@@ -0,0 +1,238 @@
+/* File Name: TFMPConfig.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Device configuration profiles for the TFMPI2C library.
+ *            See `TFMPConfig.h` for a description.
+ */
+
+#include "TFMPConfig.h"
+#include "TFMPLog.h"
+
+#if !defined( ARDUINO)
+  #include <stdio.h>
+#endif
+
+// = = = = = = = = = = =  DEVICE STATE  = = = = = = = = = = = = = =
+//
+TFMPState::TFMPState()
+  : addr( TFMP_DEFAULT_ADDRESS), frameRate( TFMP_UNKNOWN_RATE),
+    format( TFMP_UNKNOWN), output( TFMP_UNKNOWN), configHash( 0)
+{
+    memset( version, 0, sizeof( version));
+}
+
+//  Packed state:
+//  Byte0  Byte1   Byte2  Byte3-4    Byte5   Byte6   Byte7-9  Byte10-11  Byte12
+//  'S'    Layout  Addr   FrameRate  Format  Output  Version  ConfigHash CheckSum
+void TFMPState::pack( uint8_t data[]) const
+{
+    data[ 0] = 'S';
+    data[ 1] = TFMP_STATE_LAYOUT;
+    data[ 2] = addr;
+    data[ 3] = uint8_t( frameRate);
+    data[ 4] = uint8_t( frameRate >> 8);
+    data[ 5] = format;
+    data[ 6] = output;
+    memcpy( &data[ 7], version, 3);
+    data[ 10] = uint8_t( configHash);
+    data[ 11] = uint8_t( configHash >> 8);
+    uint8_t chkSum = 0;
+    for( uint8_t i = 0; i < TFMP_STATE_SIZE - 1; i++) chkSum += data[ i];
+    data[ TFMP_STATE_SIZE - 1] = chkSum;
+}
+
+bool TFMPState::unpack( const uint8_t data[])
+{
+    uint8_t chkSum = 0;
+    for( uint8_t i = 0; i < TFMP_STATE_SIZE - 1; i++) chkSum += data[ i];
+    if( data[ 0] != 'S' || data[ 1] != TFMP_STATE_LAYOUT ||
+        data[ TFMP_STATE_SIZE - 1] != chkSum) return false;
+
+    addr = data[ 2];
+    frameRate = data[ 3] | ( uint16_t( data[ 4]) << 8);
+    format = data[ 5];
+    output = data[ 6];
+    memcpy( version, &data[ 7], 3);
+    configHash = data[ 10] | ( uint16_t( data[ 11]) << 8);
+    return true;
+}
+
+#if !defined( ARDUINO)
+bool TFMPState::saveFile( const char *path) const
+{
+    uint8_t data[ TFMP_STATE_SIZE];
+    pack( data);
+    FILE *f = fopen( path, "wb");
+    if( f == NULL) return false;
+    bool ok = ( fwrite( data, 1, TFMP_STATE_SIZE, f) == TFMP_STATE_SIZE);
+    return ( fclose( f) == 0) && ok;
+}
+
+bool TFMPState::loadFile( const char *path)
+{
+    uint8_t data[ TFMP_STATE_SIZE];
+    FILE *f = fopen( path, "rb");
+    if( f == NULL) return false;
+    bool ok = ( fread( data, 1, TFMP_STATE_SIZE, f) == TFMP_STATE_SIZE);
+    fclose( f);
+    return ok && unpack( data);
+}
+#endif
+//
+// - - - - - - - - - - -  End of Device State  - - - - - - - - - - -
+
+
+// = = = = = = = = = = =  CONFIGURATION  = = = = = = = = = = = = = =
+//
+
+TFMPConfig::TFMPConfig( uint16_t frameRate, uint8_t format, bool output, uint8_t addr)
+  : frameRate( frameRate), format( format), output( output), addr( addr), sent( 0) {}
+
+bool TFMPConfig::apply( TFMPI2C &tfm, TFMPState &state, bool save)
+{
+    bool changed = false;    // a setting that needs SAVE_SETTINGS
+    sent = 0;
+    state.configHash = 0;    // not this profile until all pass
+    tfm.setFormat( format, addr);   // for data read through I2C
+
+    // - - I2C address, first, so the rest go to the new address - -
+    if( state.addr != addr)
+    {
+      ++sent;
+      if( !tfm.sendCommand( SET_I2C_ADDRESS, addr, state.addr)) return false;
+      state.addr = addr;
+    }
+
+    // - - Data frame-rate - -
+    if( state.frameRate != frameRate)
+    {
+      ++sent;
+      if( !tfm.sendCommand( SET_FRAME_RATE, frameRate, state.addr))
+      {
+        state.frameRate = TFMP_UNKNOWN_RATE;
+        return false;
+      }
+      state.frameRate = frameRate;
+      changed = true;
+    }
+
+    // - - Distance format - -
+    if( state.format != format)
+    {
+      ++sent;
+      uint32_t cmnd = ( format == TFMP_FORMAT_MM) ? STANDARD_FORMAT_MM : STANDARD_FORMAT_CM;
+      if( !tfm.sendCommand( cmnd, 0, state.addr))
+      {
+        state.format = TFMP_UNKNOWN;
+        return false;
+      }
+      state.format = format;
+      changed = true;
+    }
+
+    // - - Output enable - -
+    if( state.output != uint8_t( output))
+    {
+      ++sent;
+      if( !tfm.sendCommand( output ? ENABLE_OUTPUT : DISABLE_OUTPUT, 0, state.addr))
+      {
+        state.output = TFMP_UNKNOWN;
+        return false;
+      }
+      state.output = output;
+      changed = true;
+    }
+
+    // - - Save only if something changed - -
+    if( changed && save)
+    {
+      ++sent;
+      if( !tfm.sendCommand( SAVE_SETTINGS, 0, state.addr))
+      {
+        // Not saved, so send the settings again next time.
+        state.frameRate = TFMP_UNKNOWN_RATE;
+        state.format = TFMP_UNKNOWN;
+        state.output = TFMP_UNKNOWN;
+        return false;
+      }
+    }
+    state.configHash = hash();
+    return true;
+}
+
+// FNV-1a hash of the profile, folded to 16 bits.
+uint16_t TFMPConfig::hash() const
+{
+    uint8_t data[ 5] = { uint8_t( frameRate), uint8_t( frameRate >> 8),
+                         format, uint8_t( output), addr };
+    uint32_t h = 2166136261UL;
+    for( uint8_t i = 0; i < sizeof( data); i++)
+    {
+      h ^= data[ i];
+      h *= 16777619UL;
+    }
+    uint16_t folded = uint16_t( h ^ ( h >> 16));
+    return folded ? folded : 1;
+}
+
+bool TFMPConfig::warmStart( TFMPI2C &tfm, TFMPState &state)
+{
+    sent = 0;
+    tfm.setFormat( format, addr);
+    // - - Warm start: same profile, device answers at its address - -
+    // The device may still be starting, so keep trying for as long
+    // as it takes to start.
+    if( state.configHash == hash() && state.addr == addr)
+    {
+      TFMPBus &bus = tfm.getBus();
+      uint32_t start = bus.getMicros();
+      bool ready;
+      for( ;;)
+      {
+        if( output)
+        {
+          TFMPSample s;
+          ready = tfm.isReady( s, addr);
+          if( ready) tfm.status = TFMP_READY;
+        }
+        else   // No frames with output disabled, so ask for the version.
+        {
+          ++sent;
+          ready = tfm.sendCommand( GET_FIRMWARE_VERSION, 0, addr);
+        }
+        if( ready || ( bus.getMicros() - start) >= TFMP_BOOT_WAIT * 1000UL) break;
+        bus.wait( 1);
+      }
+      if( ready)
+      {
+        if( output) memcpy( tfm.version, state.version, 3);
+          else memcpy( state.version, tfm.version, 3);
+        return true;
+      }
+      // The settings may not be what was stored, so send them all
+      // again.  The address is kept: sending SET_I2C_ADDRESS to the
+      // default address would miss this device and could move
+      // another one that is there.
+      TFMP_LOG_WARN( "warmStart: no answer at 0x%02X, cold start", addr);
+      state.frameRate = TFMP_UNKNOWN_RATE;
+      state.format = TFMP_UNKNOWN;
+      state.output = TFMP_UNKNOWN;
+      state.configHash = 0;
+    }
+
+    // - - Cold start: send what is needed - -
+    uint8_t commands = sent;
+    if( !apply( tfm, state)) return false;
+    commands += sent;
+    if( state.version[ 0] == 0 && state.version[ 1] == 0 && state.version[ 2] == 0)
+    {
+      ++commands;
+      if( !tfm.sendCommand( GET_FIRMWARE_VERSION, 0, state.addr)) return false;
+      memcpy( state.version, tfm.version, 3);
+    }
+    sent = commands;
+    return true;
+}
+//
+// - - - - - - - - - - -  End of Configuration  - - - - - - - - - -
@@ -0,0 +1,121 @@
+/* File Name: TFMPConfig.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Device configuration profiles for the TFMPI2C library.
+ *
+ *  Setting up a device takes a series of `sendCommand()` calls, each
+ *  of which waits half a second for a reply.  A `TFMPConfig` describes
+ *  the wanted settings all at once: frame-rate, distance format, output
+ *  enable and I2C address.  A `TFMPState` holds what is already known
+ *  about the device.
+ *
+ *  'apply( tfm, state, save)'
+ *   Compares the profile with the known state and sends only the
+ *   commands for settings that differ, checking the echo of each.
+ *   `SAVE_SETTINGS` is sent only if something changed and `save` is
+ *   `true`, which spares both start up time and wear on the device's
+ *   flash memory.  Every setting that is confirmed is written back to
+ *   `state`.  Returns `true` if all commands passed.  Otherwise the
+ *   TFMPI2C `status` holds the error, and the failed setting is marked
+ *   unknown so that it will be sent again next time.
+ *
+ *  The format is also passed to `setFormat()`, so that `getData()`
+ *  reads the device in the same units.
+ *
+ *  A new `TFMPState` knows nothing but the default address, so the
+ *  first `apply()` sends every setting.  Keep the state and later
+ *  calls will send only changes.
+ *
+ *  'warmStart( tfm, state)'
+ *   For use at start up with a state that was stored before power down.
+ *   If the stored state was made by this same profile, a single frame
+ *   read at the stored address is enough to show that the device is
+ *   ready, and no commands are sent at all.  The read is tried again
+ *   for up to TFMP_BOOT_WAIT, in case the device is still starting.
+ *   Otherwise it falls back to `apply()` with every setting unknown
+ *   but the stored address, and also asks for the firmware version if
+ *   not known.
+ *
+ *  A state can be packed into TFMP_STATE_SIZE bytes with a checksum and
+ *  kept in EEPROM or flash.  `save( EEPROM, offset)` and `load( EEPROM,
+ *  offset)` work with any object that has `read( int)` and `write( int,
+ *  byte)` functions, and only write bytes that have changed.  On an ESP
+ *  call `EEPROM.commit()` afterward.  On a host computer, `saveFile()` and
+ *  `loadFile()` use a file instead.
+ *
+ *  NOTE: An I2C address change takes effect at once and is kept by
+ *  the device without a `SAVE_SETTINGS` command.
+ */
+
+#ifndef TFMPCONFIG_H       // Guard to compile only once
+#define TFMPCONFIG_H
+
+#include "TFMPI2C.h"
+
+#define TFMP_STATE_SIZE       13     // bytes in a packed state
+#define TFMP_STATE_LAYOUT      1     // layout version of a packed state
+
+// Values for a setting that is not known
+#define TFMP_UNKNOWN          0xFF
+#define TFMP_UNKNOWN_RATE     0xFFFF
+
+// What is known about one device
+struct TFMPState
+{
+    TFMPState();
+
+    uint8_t  addr;          // present I2C address
+    uint16_t frameRate;     // FRAME_x value or UNKNOWN_RATE
+    uint8_t  format;        // FORMAT_CM, FORMAT_MM or UNKNOWN
+    uint8_t  output;        // 1 = enabled, 0 = disabled, or UNKNOWN
+    uint8_t  version[ 3];   // firmware version, all zero if not known
+    uint16_t configHash;    // hash of the profile last applied, or zero
+
+    // Pack into, or unpack from, TFMP_STATE_SIZE bytes.
+    // `unpack()` returns `false` if the data is not valid.
+    void pack( uint8_t data[]) const;
+    bool unpack( const uint8_t data[]);
+
+    // Save to or load from EEPROM, flash emulation, etc.
+    template< class E> void save( E &eeprom, int offset) const
+    {
+        uint8_t data[ TFMP_STATE_SIZE];
+        pack( data);
+        for( uint8_t i = 0; i < TFMP_STATE_SIZE; i++)
+        {
+          if( eeprom.read( offset + i) != data[ i]) eeprom.write( offset + i, data[ i]);
+        }
+    }
+    template< class E> bool load( E &eeprom, int offset)
+    {
+        uint8_t data[ TFMP_STATE_SIZE];
+        for( uint8_t i = 0; i < TFMP_STATE_SIZE; i++) data[ i] = eeprom.read( offset + i);
+        return unpack( data);
+    }
+  #if !defined( ARDUINO)
+    bool saveFile( const char *path) const;
+    bool loadFile( const char *path);
+  #endif
+};
+
+// Wanted settings for one device
+struct TFMPConfig
+{
+    TFMPConfig( uint16_t frameRate = FRAME_100,
+                uint8_t format = TFMP_FORMAT_CM,
+                bool output = true,
+                uint8_t addr = TFMP_DEFAULT_ADDRESS);
+
+    uint16_t frameRate;
+    uint8_t  format;
+    bool     output;
+    uint8_t  addr;
+
+    bool apply( TFMPI2C &tfm, TFMPState &state, bool save = true);
+    bool warmStart( TFMPI2C &tfm, TFMPState &state);
+    uint16_t hash() const;  // never zero
+    uint8_t sent;           // commands sent by the last `apply()`
+};
+
+#endif
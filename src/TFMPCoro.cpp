@@ -0,0 +1,192 @@
+/* File Name: TFMPCoro.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: C++20 coroutine interface for the TFMPI2C library
+ *            on a host computer.
+ *            See `TFMPCoro.h` for a description.
+ */
+
+#include "TFMPCoro.h"
+
+#if !defined( ARDUINO) && defined( __cpp_impl_coroutine)
+
+// = = = = = = = = = = = = =  RUNNER  = = = = = = = = = = = = = = =
+//
+TFMPCoRunner::TFMPCoRunner( TFMPBus &bus)
+  : tfm( bus), tasks( 0), starting( 0), ready( NULL), readyLast( NULL), asleep( NULL) {}
+
+TFMPCoRunner::~TFMPCoRunner()
+{
+    for( uint8_t i = 0; i < tasks; i++) task[ i].destroy();
+}
+
+bool TFMPCoRunner::spawn( TFMPTask t)
+{
+    if( tasks >= TFMP_CO_MAX_TASKS)
+    {
+      t.handle.destroy();
+      return false;
+    }
+    task[ tasks++] = t.handle;
+    ++starting;
+    return true;
+}
+
+void TFMPCoRunner::submit( TFMPCoOp *op)
+{
+    op->next = NULL;
+    if( readyLast) readyLast->next = op;
+      else ready = op;
+    readyLast = op;
+}
+
+// Resume a task, and if it has finished, remove it.
+void TFMPCoRunner::resume( std::coroutine_handle<> h)
+{
+    h.resume();
+    if( !h.done()) return;
+    for( uint8_t i = 0; i < tasks; i++)
+    {
+      if( task[ i] != h) continue;
+      h.destroy();
+      // Keep the tasks not yet started at the end.
+      for( uint8_t j = i + 1; j < tasks; j++) task[ j - 1] = task[ j];
+      --tasks;
+      return;
+    }
+}
+
+bool TFMPCoRunner::runOnce()
+{
+    if( tasks == 0) return false;
+    TFMPBus &bus = tfm.getBus();
+
+    // - - Start a new task - -
+    if( starting)
+    {
+      std::coroutine_handle<> h = task[ tasks - starting];
+      --starting;
+      resume( h);
+      return true;
+    }
+
+    // - - Wake any work whose time has come - -
+    uint32_t now = bus.getMicros();
+    int32_t soonest = 0;
+    bool anyAsleep = false;
+    for( TFMPCoOp **p = &asleep; *p; )
+    {
+      TFMPCoOp *op = *p;
+      int32_t left = int32_t( op->wake - now);
+      if( left <= 0)
+      {
+        *p = op->next;
+        submit( op);
+        continue;
+      }
+      if( !anyAsleep || left < soonest) soonest = left;
+      anyAsleep = true;
+      p = &op->next;
+    }
+
+    // - - Do the next piece of work - -
+    if( ready)
+    {
+      TFMPCoOp *op = ready;
+      ready = op->next;
+      if( ready == NULL) readyLast = NULL;
+      if( op->step( tfm, bus.getMicros())) resume( op->handle);
+      else
+      {
+        op->next = asleep;
+        asleep = op;
+      }
+      return true;
+    }
+
+    // - - Nothing to do until something wakes - -
+    if( anyAsleep) bus.wait( ( uint32_t( soonest) + 999) / 1000);
+    return tasks > 0;
+}
+
+void TFMPCoRunner::run()
+{
+    while( runOnce()) {}
+}
+//
+// - - - - - - - - - - - - -  End of Runner  - - - - - - - - - - - -
+
+
+// = = = = = = = = = = = = =  AWAITABLES  = = = = = = = = = = = = = =
+//
+void TFMPCoSleep::await_suspend( std::coroutine_handle<> h)
+{
+    handle = h;
+    runner.submit( this);
+}
+
+bool TFMPCoSleep::step( TFMPI2C &, uint32_t now)
+{
+    if( started) return true;
+    started = true;
+    wake = now + ms * 1000UL;
+    return false;
+}
+
+TFMPCoSensor::TFMPCoSensor( TFMPCoRunner &runner, uint8_t addr)
+  : runner( runner), addr( addr)
+{
+    memset( version, 0, sizeof( version));
+}
+
+void TFMPCoRead::await_suspend( std::coroutine_handle<> h)
+{
+    handle = h;
+    sensor.runner.submit( this);
+}
+
+bool TFMPCoRead::step( TFMPI2C &tfm, uint32_t)
+{
+    tfm.getData( s, sensor.addr);
+    return true;
+}
+
+void TFMPCoCommand::await_suspend( std::coroutine_handle<> h)
+{
+    handle = h;
+    sensor.runner.submit( this);
+}
+
+// First send the request.  Then, if a reply is expected, poll
+// for it until it passes or TFMP_REPLY_WAIT is over.
+bool TFMPCoCommand::step( TFMPI2C &tfm, uint32_t now)
+{
+    if( !sent)
+    {
+      sent = true;
+      start = now;
+      bool ok = tfm.sendRequest( cmnd, param, sensor.addr);
+      status = tfm.status;
+      // The low byte of a command is its reply length.
+      if( !ok || ( cmnd & 0xFF) == 0) return true;
+      wake = now + TFMP_CO_POLL * 1000UL;
+      return false;
+    }
+    bool ok = tfm.getReply( cmnd, param, sensor.addr);
+    status = tfm.status;
+    if( ok)
+    {
+      if( cmnd == GET_FIRMWARE_VERSION) memcpy( sensor.version, tfm.version, 3);
+      // A new address takes effect at once.
+      if( cmnd == SET_I2C_ADDRESS) sensor.addr = uint8_t( param);
+      return true;
+    }
+    if( ( now - start) >= TFMP_REPLY_WAIT * 1000UL) return true;
+    wake = now + TFMP_CO_POLL * 1000UL;
+    return false;
+}
+//
+// - - - - - - - - - - - - -  End of Awaitables  - - - - - - - - - - - -
+
+#endif  // !ARDUINO && __cpp_impl_coroutine
@@ -0,0 +1,178 @@
+/* File Name: TFMPCoro.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: C++20 coroutine interface for the TFMPI2C library
+ *            on a host computer.
+ *
+ *  `sendCommand()` blocks for half a second while it waits for a reply,
+ *  and a program that talks to many sensors must either wait for each
+ *  in turn or keep a state machine for every one.  With coroutines,
+ *  each sensor can have its own straight-line code:
+ *
+ *      TFMPTask watch( TFMPCoSensor &sensor)
+ *      {
+ *          co_await sensor.command( SET_FRAME_RATE, FRAME_200);
+ *          for( ;;)
+ *          {
+ *              TFMPSample s = co_await sensor.read();
+ *              ...
+ *              co_await sensor.runner.sleep( 10);
+ *          }
+ *      }
+ *
+ *  A `TFMPCoRunner` owns the bus and drives every task on one thread.
+ *  Each bus transfer is queued, and the task is suspended until the
+ *  runner has made it.  While a command waits for its reply, the
+ *  runner polls for the reply now and then and runs other tasks in the
+ *  meantime.  Transfers are made one at a time, in the order asked for.
+ *
+ *  'spawn( task)' adds a task, up to TFMP_CO_MAX_TASKS at once.
+ *  'run()' runs until every task has finished.  'runOnce()' does one
+ *   piece of work, or nothing, and returns `false` when no tasks are left.
+ *
+ *  An awaited `read()` gives a `TFMPSample`.  An awaited `command()`
+ *  gives the TFMPI2C status code, TFMP_READY if it passed.  After
+ *  GET_FIRMWARE_VERSION, the sensor `version` is filled in.
+ *
+ *  Nothing is allocated but the coroutine frames themselves.
+ *  Only for a host compiler with C++20 coroutines.
+ */
+
+#ifndef TFMPCORO_H       // Guard to compile only once
+#define TFMPCORO_H
+
+#include "TFMPI2C.h"
+
+#if !defined( ARDUINO) && defined( __cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+
+#ifndef TFMP_CO_MAX_TASKS
+#define TFMP_CO_MAX_TASKS     32
+#endif
+#define TFMP_CO_POLL           5   // ms between polls for a command reply
+
+class TFMPCoRunner;
+
+// One queued piece of bus work.  It lives in the suspended coroutine.
+struct TFMPCoOp
+{
+    TFMPCoOp *next;
+    std::coroutine_handle<> handle;
+    uint32_t wake;            // bus time to run again, if asleep
+    virtual ~TFMPCoOp() {}
+    // Do the next step.  Returns `true` when finished, or `false`
+    // with `wake` set to the time to do the next step.
+    virtual bool step( TFMPI2C &tfm, uint32_t now) = 0;
+};
+
+// Return type of a coroutine that the runner can drive
+class TFMPTask
+{
+  public:
+    struct promise_type
+    {
+        TFMPTask get_return_object()
+        {
+            return TFMPTask( std::coroutine_handle< promise_type>::from_promise( *this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    explicit TFMPTask( std::coroutine_handle< promise_type> h) : handle( h) {}
+    std::coroutine_handle< promise_type> handle;
+};
+
+// Awaitable pause
+struct TFMPCoSleep : TFMPCoOp
+{
+    TFMPCoSleep( TFMPCoRunner &runner, uint32_t ms) : runner( runner), ms( ms), started( false) {}
+    bool await_ready() { return false; }
+    void await_suspend( std::coroutine_handle<> h);
+    void await_resume() {}
+    bool step( TFMPI2C &tfm, uint32_t now);
+
+    TFMPCoRunner &runner;
+    uint32_t ms;
+    bool started;
+};
+
+class TFMPCoRunner
+{
+  public:
+    TFMPCoRunner( TFMPBus &bus);
+    ~TFMPCoRunner();
+
+    bool spawn( TFMPTask task);
+    void run();
+    bool runOnce();
+
+    TFMPCoSleep sleep( uint32_t ms) { return TFMPCoSleep( *this, ms); }
+    void submit( TFMPCoOp *op);
+    TFMPI2C tfm;              // used for every transfer
+
+  private:
+    std::coroutine_handle<> task[ TFMP_CO_MAX_TASKS];
+    uint8_t tasks;
+    uint8_t starting;         // tasks not yet started, at the end of `task`
+    TFMPCoOp *ready;          // FIFO of work to do now
+    TFMPCoOp *readyLast;
+    TFMPCoOp *asleep;         // work waiting for its `wake` time
+
+    void resume( std::coroutine_handle<> h);
+};
+
+class TFMPCoSensor;
+
+struct TFMPCoRead : TFMPCoOp
+{
+    TFMPCoRead( TFMPCoSensor &sensor) : sensor( sensor) {}
+    bool await_ready() { return false; }
+    void await_suspend( std::coroutine_handle<> h);
+    TFMPSample await_resume() { return s; }
+    bool step( TFMPI2C &tfm, uint32_t now);
+
+    TFMPCoSensor &sensor;
+    TFMPSample s;
+};
+
+struct TFMPCoCommand : TFMPCoOp
+{
+    TFMPCoCommand( TFMPCoSensor &sensor, uint32_t cmnd, uint32_t param)
+      : sensor( sensor), cmnd( cmnd), param( param), sent( false), start( 0), status( TFMP_READY) {}
+    bool await_ready() { return false; }
+    void await_suspend( std::coroutine_handle<> h);
+    uint8_t await_resume() { return status; }
+    bool step( TFMPI2C &tfm, uint32_t now);
+
+    TFMPCoSensor &sensor;
+    uint32_t cmnd;
+    uint32_t param;
+    bool sent;
+    uint32_t start;           // time the request was sent
+    uint8_t status;
+};
+
+class TFMPCoSensor
+{
+  public:
+    TFMPCoSensor( TFMPCoRunner &runner, uint8_t addr = TFMP_DEFAULT_ADDRESS);
+
+    TFMPCoRead read() { return TFMPCoRead( *this); }
+    TFMPCoCommand command( uint32_t cmnd, uint32_t param = 0)
+    {
+        return TFMPCoCommand( *this, cmnd, param);
+    }
+
+    TFMPCoRunner &runner;
+    uint8_t addr;
+    uint8_t version[ 3];      // set by GET_FIRMWARE_VERSION
+};
+
+#endif  // !ARDUINO && __cpp_impl_coroutine
+
+#endif
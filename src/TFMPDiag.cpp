@@ -0,0 +1,130 @@
+/* File Name: TFMPDiag.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Diagnostic output for the TFMPI2C library.
+ *            See `TFMPDiag.h` for a description.
+ */
+
+#include "TFMPDiag.h"
+#include "TFMPI2C.h"
+
+#if defined( ARDUINO) && !defined( TFMP_NO_DIAG)
+
+// = = = = = = = = = = =  STATUS NAMES  = = = = = = = = = = = = = =
+//
+static const char nameReady[]    PROGMEM = "READY";
+static const char nameSerial[]   PROGMEM = "SERIAL";
+static const char nameHeader[]   PROGMEM = "HEADER";
+static const char nameChecksum[] PROGMEM = "CHECKSUM";
+static const char nameTimeout[]  PROGMEM = "TIMEOUT";
+static const char namePass[]     PROGMEM = "PASS";
+static const char nameFail[]     PROGMEM = "FAIL";
+static const char nameRead[]     PROGMEM = "I2C-READ";
+static const char nameWrite[]    PROGMEM = "I2C-WRITE";
+static const char nameLength[]   PROGMEM = "I2C-LENGTH";
+static const char nameWeak[]     PROGMEM = "Signal weak";
+static const char nameStrong[]   PROGMEM = "Signal saturation";
+static const char nameFlood[]    PROGMEM = "Ambient light saturation";
+static const char nameMeasure[]  PROGMEM = "MEASURE";
+static const char nameEcho[]     PROGMEM = "ECHO";
+static const char nameOther[]    PROGMEM = "OTHER";
+
+// In the order of the status codes, READY = 0 to ECHO = 14
+static const char *const statusNames[] PROGMEM =
+{
+    nameReady, nameSerial, nameHeader, nameChecksum, nameTimeout,
+    namePass, nameFail, nameRead, nameWrite, nameLength,
+    nameWeak, nameStrong, nameFlood, nameMeasure, nameEcho
+};
+
+const __FlashStringHelper *TFMPStatusName( uint8_t status)
+{
+    const char *name = nameOther;
+    if( status < sizeof( statusNames) / sizeof( statusNames[ 0]))
+    {
+      name = (const char *)pgm_read_ptr( &statusNames[ status]);
+    }
+    return (const __FlashStringHelper *)name;
+}
+//
+// - - - - - - - - - - -  End of Status Names  - - - - - - - - - - -
+
+
+// = = = = = = = = = = =  BUFFERED SINK  = = = = = = = = = = = = = =
+//
+TFMPDiagSink::TFMPDiagSink( Print &out)
+  : dropped( 0), out( out), head( 0), count( 0) {}
+
+size_t TFMPDiagSink::write( uint8_t c)
+{
+    if( count >= TFMP_DIAG_BUFFER)
+    {
+      ++dropped;
+      return 0;
+    }
+    buffer[ head] = c;
+    head = ( head + 1) % TFMP_DIAG_BUFFER;
+    ++count;
+    return 1;
+}
+
+// Keep all of the text or none of it, so that
+// a line is never cut off in the middle.
+size_t TFMPDiagSink::write( const uint8_t *data, size_t len)
+{
+    if( len > size_t( TFMP_DIAG_BUFFER - count))
+    {
+      dropped += len;
+      return 0;
+    }
+    for( size_t i = 0; i < len; i++) write( data[ i]);
+    return len;
+}
+
+int TFMPDiagSink::availableForWrite()
+{
+    return TFMP_DIAG_BUFFER - count;
+}
+
+// Send the oldest `len` bytes, at most up to the end of the buffer.
+// Returns the number the output took.  The rest stay in the buffer.
+uint16_t TFMPDiagSink::send( uint16_t len)
+{
+    uint16_t tail = ( head + TFMP_DIAG_BUFFER - count) % TFMP_DIAG_BUFFER;
+    if( len > TFMP_DIAG_BUFFER - tail) len = TFMP_DIAG_BUFFER - tail;
+    size_t sent = out.write( &buffer[ tail], len);
+    if( sent > len) sent = len;
+    count -= uint16_t( sent);
+    return uint16_t( sent);
+}
+
+void TFMPDiagSink::service()
+{
+    while( count > 0)
+    {
+      int room = out.availableForWrite();
+      if( room <= 0) return;
+      // Try again next time if the output took none after all.
+      if( send( ( room < count) ? uint16_t( room) : count) == 0) return;
+    }
+}
+
+void TFMPDiagSink::flush()
+{
+    while( count > 0)
+    {
+      // An output that takes nothing even when it may wait
+      // never will, so throw the rest away and count it.
+      if( send( count) == 0)
+      {
+        dropped += count;
+        count = 0;
+      }
+    }
+    out.flush();
+}
+//
+// - - - - - - - - - - -  End of Buffered Sink  - - - - - - - - - - -
+
+#endif
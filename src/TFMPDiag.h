@@ -0,0 +1,74 @@
+/* File Name: TFMPDiag.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Diagnostic output for the TFMPI2C library.
+ *
+ *  `printFrame()` and `printReply()` used to make a few dozen
+ *  `Serial.print()` calls each, with every status name held in RAM.
+ *  Now they format a whole line into a small buffer on the stack and
+ *  hand it to any `Print` object in one `write()`.  The status names
+ *  are kept in a table in flash memory.
+ *
+ *  'TFMPStatusName( status)' passes back the name of a status code as
+ *   a flash string that can be given to `print()`.
+ *
+ *  A `Print` object such as `Serial` still blocks if its own transmit
+ *  buffer is full.  To keep diagnostics out of the way of the main loop,
+ *  print them to a `TFMPDiagSink` instead.  It keeps TFMP_DIAG_BUFFER
+ *  bytes and passes them on to the real output only as fast as that
+ *  output can take them without waiting:
+ *    'service()' sends as many bytes as `out.availableForWrite()`
+ *     says will fit.  Call it from the main loop.
+ *    'flush()' sends everything, waiting if it must.
+ *  Text that does not fit in the sink is thrown away, and `dropped`
+ *  counts the bytes lost.  Bytes the output does not take stay in the
+ *  sink for next time, except in a `flush()` that the output takes
+ *  nothing from at all, where they are thrown away and counted too.  An output that does not report its free
+ *  space, i.e. whose `availableForWrite()` is always zero, can only be
+ *  emptied with `flush()`.
+ *
+ *  Define TFMP_NO_DIAG for the whole build to leave out every
+ *  diagnostic.  `printFrame()` and `printReply()` still compile but do
+ *  nothing, and none of the strings take up flash.
+ */
+
+#ifndef TFMPDIAG_H       // Guard to compile only once
+#define TFMPDIAG_H
+
+#include "TFMPBus.h"
+
+#if defined( ARDUINO) && !defined( TFMP_NO_DIAG)
+
+#ifndef TFMP_DIAG_BUFFER
+#define TFMP_DIAG_BUFFER    64   // bytes held by a TFMPDiagSink
+#endif
+
+const __FlashStringHelper *TFMPStatusName( uint8_t status);
+
+class TFMPDiagSink : public Print
+{
+  public:
+    TFMPDiagSink( Print &out);
+
+    size_t write( uint8_t c);
+    size_t write( const uint8_t *data, size_t len);
+    using Print::write;
+    int availableForWrite();
+
+    void service();
+    void flush();
+
+    uint32_t dropped;     // bytes thrown away because the sink was full
+
+  private:
+    Print &out;
+    uint8_t buffer[ TFMP_DIAG_BUFFER];
+    uint16_t head;        // next byte to fill
+    uint16_t count;       // bytes waiting
+
+    uint16_t send( uint16_t len);
+};
+
+#endif
+#endif
@@ -0,0 +1,83 @@
+/* File Name: TFMPDuplicate.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Repeated frame detection for the TFMPI2C library.
+ *            See `TFMPDuplicate.h` for a description.
+ */
+
+#include "TFMPDuplicate.h"
+
+TFMPDuplicate::TFMPDuplicate( uint16_t frameRate)
+  : window( frameRate ? 1000000UL / frameRate : 0)
+{
+    reset();
+}
+
+TFMPDuplicate::TFMPDuplicate( uint16_t frameRate, uint32_t window)
+  : window( frameRate ? window : 0)
+{
+    reset();
+}
+
+void TFMPDuplicate::reset()
+{
+    rate = 0;
+    unique = 0;
+    repeated = 0;
+    first = true;
+    lastDist = 0;
+    lastFlux = 0;
+    lastTemp = 0;
+    lastTime = 0;
+    rateStart = 0;
+    rateCount = 0;
+}
+
+bool TFMPDuplicate::check( TFMPSample &s)
+{
+    // A failed read is neither new nor repeated.
+    if( s.status != TFMP_READY && s.status != TFMP_WEAK &&
+        s.status != TFMP_STRONG && s.status != TFMP_FLOOD)
+    {
+      countRate( s.time);
+      return false;
+    }
+
+    bool same = !first && s.dist == lastDist &&
+                s.flux == lastFlux && s.temp == lastTemp;
+    if( same && ( window == 0 || ( s.time - lastTime) < window))
+    {
+      s.flags |= TFMP_SAMPLE_DUP;
+      ++repeated;
+      countRate( s.time);
+      return false;
+    }
+
+    // - - A new frame - -
+    if( first) rateStart = s.time;
+      else ++rateCount;
+    first = false;
+    lastDist = s.dist;
+    lastFlux = s.flux;
+    lastTemp = s.temp;
+    lastTime = s.time;
+    ++unique;
+    countRate( s.time);
+    return true;
+}
+
+// Count new frames over each whole second.  If more than one second
+// has passed, scale the count to one second.  Repeated frames and
+// failed reads end a second too, so if new frames stop it goes to zero.
+void TFMPDuplicate::countRate( uint32_t time)
+{
+    if( first) return;
+    uint32_t span = time - rateStart;
+    if( span >= 1000000UL)
+    {
+      rate = uint16_t( ( uint64_t( rateCount) * 1000000UL) / span);
+      rateStart = time;
+      rateCount = 0;
+    }
+}
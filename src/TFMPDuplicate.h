@@ -0,0 +1,63 @@
+/* File Name: TFMPDuplicate.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Repeated frame detection for the TFMPI2C library.
+ *
+ *  The device makes a new frame at its frame-rate and passes back the
+ *  latest one every time it is asked.  If `getData()` is called more
+ *  often than that, some frames are read twice, and averages or rates
+ *  worked out from them are thrown off.
+ *
+ *  A `TFMPDuplicate` object, one for each sensor, compares each sample
+ *  with the last one.  A frame with exactly the same distance, flux and
+ *  temperature, read less than one frame period after the last new
+ *  frame, is a repeat.  It gets the TFMP_SAMPLE_DUP bit in `flags` and
+ *  `check()` returns `false`.  A still target can send the same values
+ *  twice in a row, so a match that comes a whole frame period or more
+ *  later counts as new.  With a frame-rate of zero (triggered), every
+ *  match is a repeat.
+ *
+ *  'rate' is the number of new frames in the last full second.  It is
+ *  brought up to date by repeated frames and failed reads as well as
+ *  new frames, so if new frames stop coming it falls to zero.  If it is well
+ *  below the polling rate, the polling can slow down.
+ */
+
+#ifndef TFMPDUPLICATE_H       // Guard to compile only once
+#define TFMPDUPLICATE_H
+
+#include "TFMPI2C.h"
+
+class TFMPDuplicate
+{
+  public:
+    // `frameRate` is the device frame-rate in Hz, as set by
+    // SET_FRAME_RATE, or zero if frames are triggered.
+    TFMPDuplicate( uint16_t frameRate = 100);
+    // As above, but a match less than `window` microseconds after
+    // the last new frame is a repeat, instead of one frame period.
+    TFMPDuplicate( uint16_t frameRate, uint32_t window);
+
+    // Mark the sample if it repeats the last one.
+    // Returns `true` if it is new.
+    bool check( TFMPSample &s);
+    // Forget the last frame and clear all counts.
+    void reset();
+
+    uint16_t rate;           // new frames in the last second
+    uint32_t unique;         // new frames seen
+    uint32_t repeated;       // repeated frames seen
+
+  private:
+    uint32_t window;         // repeat window in microseconds, or zero
+    bool first;
+    int16_t lastDist, lastFlux, lastTemp;
+    uint32_t lastTime;       // time of the last new frame
+    uint32_t rateStart;      // start of the present rate second
+    uint16_t rateCount;      // new frames so far in that second
+
+    void countRate( uint32_t time);
+};
+
+#endif
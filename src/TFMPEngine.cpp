@@ -0,0 +1,227 @@
+/* File Name: TFMPEngine.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Multi-threaded acquisition for the TFMPI2C library
+ *            on a Linux host.
+ *            See `TFMPEngine.h` for a description.
+ */
+
+// Not built with TFMP_COMPACT, see `TFMPEngine.h`.
+#if !defined( ARDUINO) && !defined( TFMP_COMPACT)
+
+#include "TFMPEngine.h"
+
+#if defined( __linux__)
+  #include <unistd.h>
+  #include <sys/eventfd.h>
+  #include <sys/timerfd.h>
+#endif
+
+#define TFMP_ENGINE_NAP_US      1000      // longest worker sleep
+#define TFMP_ENGINE_IDLE_US  1000000UL   // timer when nothing is due
+
+TFMPEngine::TFMPEngine() : adapters( 0), nextRead( 0), run( false), polled( false)
+{
+  #if defined( __linux__)
+    timer = -1;
+    event = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC);
+  #endif
+}
+
+TFMPEngine::~TFMPEngine()
+{
+    stop();
+    for( uint8_t i = 0; i < adapters; i++) delete adapter[ i];
+  #if defined( __linux__)
+    if( event >= 0) close( event);
+  #endif
+}
+
+// Tell the reader that there are samples in a ring.
+void TFMPEngine::signal()
+{
+  #if defined( __linux__)
+    if( event < 0) return;
+    uint64_t one = 1;
+    ssize_t n = ::write( event, &one, sizeof( one));
+    (void)n;    // a full counter still leaves the eventfd readable
+  #endif
+}
+
+int8_t TFMPEngine::addAdapter( TFMPBus &bus)
+{
+    if( run.load() || adapters >= TFMP_ENGINE_MAX_ADAPTERS) return -1;
+    adapter[ adapters] = new Adapter( bus);
+    return adapters++;
+}
+
+int8_t TFMPEngine::addSensor( uint8_t index, uint8_t addr, uint16_t rate)
+{
+    if( run.load() || index >= adapters) return -1;
+    return adapter[ index]->sched.add( addr, rate);
+}
+
+bool TFMPEngine::start()
+{
+    if( run.load() || adapters == 0) return false;
+    run.store( true);
+    for( uint8_t i = 0; i < adapters; i++)
+    {
+      Adapter &a = *adapter[ i];
+      a.sched.begin( a.tfm.getBus().getMicros());
+      a.thread = std::thread( &TFMPEngine::work, this, i);
+    }
+    return true;
+}
+
+void TFMPEngine::stop()
+{
+    if( !run.load()) return;
+    run.store( false);
+    for( uint8_t i = 0; i < adapters; i++)
+    {
+      if( adapter[ i]->thread.joinable()) adapter[ i]->thread.join();
+    }
+  #if defined( __linux__)
+    if( timer >= 0) close( timer);
+    timer = -1;
+  #endif
+    polled = false;
+}
+
+#if defined( __linux__)
+// = = = = = = = = =  RUN FROM AN EVENT LOOP  = = = = = = = = = = =
+//
+bool TFMPEngine::startPolled()
+{
+    if( run.load() || adapters == 0) return false;
+    timer = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if( timer < 0) return false;
+    run.store( true);
+    polled = true;
+    for( uint8_t i = 0; i < adapters; i++)
+    {
+      adapter[ i]->sched.begin( adapter[ i]->tfm.getBus().getMicros());
+    }
+    service();
+    return true;
+}
+
+// Make every read that is due, then set the timer for the next.
+void TFMPEngine::service()
+{
+    if( !polled) return;
+    uint64_t expired;
+    ssize_t n = ::read( timer, &expired, sizeof( expired));
+    (void)n;    // nothing to read if called before the timer ran out
+
+    uint32_t next = TFMP_ENGINE_IDLE_US;
+    bool any = false;
+    for( uint8_t i = 0; i < adapters; i++)
+    {
+      // At most one read of each sensor, so that a bus that cannot
+      // keep up does not keep the event loop here for ever.  An
+      // adapter with no sensors has nothing due.
+      Adapter &a = *adapter[ i];
+      uint32_t waitMicros = TFMP_ENGINE_IDLE_US;
+      uint8_t k = 0;
+      for( ; k < a.sched.count(); k++)
+      {
+        if( !poll( i, waitMicros)) break;
+        any = true;
+      }
+      // If every sensor was read, ask when the next one is due.
+      if( k > 0 && k == a.sched.count()) a.sched.due( a.tfm.getBus().getMicros(), waitMicros);
+      if( waitMicros < next) next = waitMicros;
+    }
+    if( any) signal();
+
+    // A zero time would turn the timer off, so wait at least 1us.
+    struct itimerspec when;
+    memset( &when, 0, sizeof( when));
+    if( next == 0) next = 1;
+    when.it_value.tv_sec = next / 1000000UL;
+    when.it_value.tv_nsec = long( next % 1000000UL) * 1000L;
+    timerfd_settime( timer, 0, &when, NULL);
+}
+
+void TFMPEngine::ackEvent()
+{
+    uint64_t count;
+    ssize_t n = ::read( event, &count, sizeof( count));
+    (void)n;
+}
+//
+// - - - - - - - - -  End of Run from an Event Loop  - - - - - - - - -
+#endif  // __linux__
+
+// Make one read if one is due.  Returns `true` if a sample was read,
+// otherwise `waitMicros` is the time until the next one is due.
+bool TFMPEngine::poll( uint8_t index, uint32_t &waitMicros)
+{
+    Adapter &a = *adapter[ index];
+    TFMPBus &bus = a.tfm.getBus();
+    int8_t i = a.sched.due( bus.getMicros(), waitMicros);
+    if( i < 0) return false;
+
+    TFMPEngineSample e;
+    e.adapter = index;
+    e.sensor = i;
+    e.addr = a.sched.addr( i);
+    a.tfm.getData( e.s, e.addr);
+    a.sched.done( i, bus.getMicros());
+    if( a.ring.push( e)) a.samples.fetch_add( 1, std::memory_order_relaxed);
+      else a.dropped.fetch_add( 1, std::memory_order_relaxed);
+    return true;
+}
+
+// Worker thread for one adapter
+void TFMPEngine::work( uint8_t index)
+{
+    while( run.load( std::memory_order_relaxed))
+    {
+      uint32_t waitMicros;
+      if( poll( index, waitMicros))
+      {
+        signal();
+        continue;
+      }
+      // Sleep until the next read, but wake now and then to see
+      // whether the engine has been stopped.
+      delayMicroseconds( waitMicros < TFMP_ENGINE_NAP_US ? waitMicros : TFMP_ENGINE_NAP_US);
+    }
+}
+
+uint16_t TFMPEngine::read( uint8_t index, TFMPEngineSample list[], uint16_t max)
+{
+    if( index >= adapters) return 0;
+    uint16_t n = 0;
+    while( n < max && adapter[ index]->ring.pop( list[ n])) ++n;
+    return n;
+}
+
+uint16_t TFMPEngine::readAll( TFMPEngineSample list[], uint16_t max)
+{
+    uint16_t n = 0;
+    // Start with a different adapter each time, so that
+    // a busy one cannot always fill the list first.
+    for( uint8_t k = 0; k < adapters && n < max; k++)
+    {
+      n += read( ( nextRead + k) % adapters, &list[ n], max - n);
+    }
+    if( adapters) nextRead = ( nextRead + 1) % adapters;
+    return n;
+}
+
+uint32_t TFMPEngine::samples( uint8_t index) const
+{
+    return ( index < adapters) ? adapter[ index]->samples.load() : 0;
+}
+
+uint32_t TFMPEngine::dropped( uint8_t index) const
+{
+    return ( index < adapters) ? adapter[ index]->dropped.load() : 0;
+}
+
+#endif  // !ARDUINO
@@ -0,0 +1,168 @@
+/* File Name: TFMPEngine.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Multi-threaded acquisition for the TFMPI2C library
+ *            on a Linux host.
+ *
+ *  A Linux gateway can have sensors on several I2C adapters, and each
+ *  adapter can run a transfer at the same time as the others.  A
+ *  `TFMPEngine` starts one worker thread for each adapter.  Each worker
+ *  has its own TFMPI2C object and a `TFMPScheduler`, reads its sensors
+ *  as their deadlines come due, and puts the samples in a ring buffer.
+ *  No locks are needed: only one worker uses each bus, and each ring
+ *  has only one writer and one reader.
+ *
+ *  'addAdapter( bus)' returns the adapter index, or -1 if full.
+ *  'addSensor( adapter, addr, rate)' returns the sensor index on that
+ *   adapter, or -1 if full.  Add everything before `start()`.
+ *  'start()' and 'stop()' start and stop the worker threads.
+ *  'read( adapter, list, max)' moves up to `max` samples from that
+ *   adapter's ring into `list` and returns the number moved.  Each
+ *   adapter's ring must be read by only one thread.
+ *  'readAll( list, max)' does the same for every adapter in turn, for
+ *   use when a single thread reads everything.
+ *
+ *  If a ring is full, new samples are dropped and counted.
+ *
+ *  On Linux the engine can also be run from an application's own
+ *  `epoll()` or `poll()` loop, with no threads at all:
+ *  'startPolled()' arms a timer instead of starting the workers.
+ *   When `timerFd()` is readable, call `service()`, which makes every
+ *   read that is due on every adapter and sets the timer for the next.
+ *  'eventFd()' is readable whenever samples have been put in a ring,
+ *   in either mode.  Call `ackEvent()` to clear it, then empty the
+ *   rings with `readAll()` until it returns less than `max`.
+ *
+ *  Only for a host computer.  Nothing here is compiled for an Arduino.
+ */
+
+#ifndef TFMPENGINE_H       // Guard to compile only once
+#define TFMPENGINE_H
+
+#include "TFMPScheduler.h"
+
+#if !defined( ARDUINO)
+
+#if defined( TFMP_COMPACT)
+  // TFMP_COMPACT objects share one set of buffers, see `TFMPI2C.h`.
+  #error "TFMPEngine cannot be used with TFMP_COMPACT."
+#endif
+
+#include <atomic>
+#include <thread>
+
+#ifndef TFMP_ENGINE_MAX_ADAPTERS
+#define TFMP_ENGINE_MAX_ADAPTERS   8
+#endif
+#ifndef TFMP_ENGINE_RING
+#define TFMP_ENGINE_RING         256   // samples in each ring, a power of 2
+#endif
+
+// Ring buffer for one writer thread and one reader thread
+template< class T, uint16_t N> class TFMPRing
+{
+    // Indexes are masked with N - 1 and counted in 16 bits.
+    static_assert( N != 0 && ( N & ( N - 1)) == 0 && N <= 32768,
+                   "TFMP_ENGINE_RING must be a power of 2, 32768 at most");
+
+  public:
+    TFMPRing() : head( 0), tail( 0) {}
+
+    bool push( const T &item)
+    {
+        uint16_t h = head.load( std::memory_order_relaxed);
+        if( uint16_t( h - tail.load( std::memory_order_acquire)) >= N) return false;
+        buf[ h & ( N - 1)] = item;
+        head.store( uint16_t( h + 1), std::memory_order_release);
+        return true;
+    }
+    bool pop( T &item)
+    {
+        uint16_t t = tail.load( std::memory_order_relaxed);
+        if( t == head.load( std::memory_order_acquire)) return false;
+        item = buf[ t & ( N - 1)];
+        tail.store( uint16_t( t + 1), std::memory_order_release);
+        return true;
+    }
+    uint16_t size() const
+    {
+        return uint16_t( head.load( std::memory_order_acquire) -
+                         tail.load( std::memory_order_acquire));
+    }
+
+  private:
+    T buf[ N];
+    std::atomic< uint16_t> head;   // next to write
+    std::atomic< uint16_t> tail;   // next to read
+};
+
+// A sample and where it came from
+struct TFMPEngineSample
+{
+    uint8_t adapter;       // adapter index
+    uint8_t sensor;        // sensor index on that adapter
+    uint8_t addr;          // I2C address
+    TFMPSample s;
+};
+
+class TFMPEngine
+{
+  public:
+    TFMPEngine();
+    ~TFMPEngine();
+
+    int8_t addAdapter( TFMPBus &bus);
+    int8_t addSensor( uint8_t adapter, uint8_t addr, uint16_t rate);
+
+    bool start();
+    void stop();
+    bool running() const { return run.load(); }
+
+  #if defined( __linux__)
+    bool startPolled();
+    void service();
+    int timerFd() const { return timer; }
+    int eventFd() const { return event; }
+    void ackEvent();
+  #endif
+
+    uint16_t read( uint8_t adapter, TFMPEngineSample list[], uint16_t max);
+    uint16_t readAll( TFMPEngineSample list[], uint16_t max);
+
+    uint32_t samples( uint8_t adapter) const;   // samples put in the ring
+    uint32_t dropped( uint8_t adapter) const;   // samples lost to a full ring
+
+  private:
+    struct Adapter
+    {
+        Adapter( TFMPBus &bus) : tfm( bus), samples( 0), dropped( 0) {}
+        TFMPI2C tfm;
+        TFMPScheduler sched;
+        TFMPRing< TFMPEngineSample, TFMP_ENGINE_RING> ring;
+        std::thread thread;
+        std::atomic< uint32_t> samples;
+        std::atomic< uint32_t> dropped;
+    };
+    Adapter *adapter[ TFMP_ENGINE_MAX_ADAPTERS];
+    uint8_t adapters;
+    uint8_t nextRead;      // adapter that `readAll()` starts with
+    std::atomic< bool> run;
+    bool polled;           // run by `service()` instead of threads
+  #if defined( __linux__)
+    int timer;             // timerfd for `startPolled()`, or -1
+    int event;             // eventfd, readable when samples are ready
+  #endif
+
+    void signal();
+
+    void work( uint8_t index);
+    bool poll( uint8_t index, uint32_t &waitMicros);
+
+    TFMPEngine( const TFMPEngine &);
+    TFMPEngine &operator=( const TFMPEngine &);
+};
+
+#endif  // !ARDUINO
+
+#endif
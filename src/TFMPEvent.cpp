@@ -0,0 +1,95 @@
+/* File Name: TFMPEvent.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Change detection for the TFMPI2C library.
+ *            See `TFMPEvent.h` for a description.
+ */
+
+#include "TFMPEvent.h"
+
+TFMPEvent::TFMPEvent( uint16_t deadband, uint32_t heartbeat)
+  : deadband( deadband), heartbeat( heartbeat * 1000UL), thresholds( 0)
+{
+    reset();
+}
+
+void TFMPEvent::reset()
+{
+    reason = 0;
+    zone = 0;
+    passed = 0;
+    dropped = 0;
+    first = true;
+    lastDist = 0;
+    lastStatus = TFMP_READY;
+    lastTime = 0;
+    above = 0;
+}
+
+bool TFMPEvent::addThreshold( int16_t newLevel, uint16_t newHysteresis)
+{
+    if( thresholds >= TFMP_EVENT_MAX_THRESHOLDS) return false;
+    level[ thresholds] = newLevel;
+    hysteresis[ thresholds] = newHysteresis;
+    ++thresholds;
+    return true;
+}
+
+bool TFMPEvent::check( const TFMPSample &s)
+{
+    reason = 0;
+    bool good = ( s.status == TFMP_READY);
+
+    if( first) reason |= TFMP_EVENT_FIRST;
+    if( !first && s.status != lastStatus) reason |= TFMP_EVENT_STATUS;
+
+    if( good)
+    {
+      // - - Distance change beyond the deadband - -
+      int32_t diff = int32_t( s.dist) - lastDist;
+      if( !first && ( diff > deadband || -diff > deadband))
+      {
+        reason |= TFMP_EVENT_CHANGE;
+      }
+
+      // - - Threshold crossings with hysteresis - -
+      uint8_t newAbove = above;
+      for( uint8_t i = 0; i < thresholds; i++)
+      {
+        uint8_t bit = 1 << i;
+        if( int32_t( s.dist) > int32_t( level[ i]) + hysteresis[ i])
+        {
+          newAbove |= bit;
+        }
+        else if( int32_t( s.dist) < int32_t( level[ i]) - hysteresis[ i])
+        {
+          newAbove &= ~bit;
+        }
+      }
+      if( !first && newAbove != above) reason |= TFMP_EVENT_CROSS;
+      above = newAbove;
+      zone = 0;
+      for( uint8_t i = 0; i < thresholds; i++) if( above & ( 1 << i)) ++zone;
+    }
+
+    // - - Heartbeat - -
+    if( heartbeat != 0 && !first && ( s.time - lastTime) >= heartbeat)
+    {
+      reason |= TFMP_EVENT_HEARTBEAT;
+    }
+
+    lastStatus = s.status;
+    if( reason == 0)
+    {
+      ++dropped;
+      return false;
+    }
+
+    // Only a good sample moves the deadband reference.
+    if( good) lastDist = s.dist;
+    lastTime = s.time;
+    first = false;
+    ++passed;
+    return true;
+}
@@ -0,0 +1,74 @@
+/* File Name: TFMPEvent.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Change detection for the TFMPI2C library.
+ *
+ *  A sensor watching a still scene sends the same distance over and
+ *  over again.  A `TFMPEvent` object, one for each sensor, looks at
+ *  every sample and passes on only those that matter:
+ *    - the distance has moved more than a 'deadband' since the last
+ *      sample passed on,
+ *    - the distance has crossed one of up to four thresholds, each
+ *      with its own hysteresis,
+ *    - the `status` has changed, or
+ *    - nothing has been passed on for a 'heartbeat' period.
+ *  Every sample is still read, so a real change is passed on at once.
+ *
+ *  'check( sample)' returns `true` if the sample should be passed on
+ *  and sets `reason` to the TFMP_EVENT bits that caused it.  `zone` is
+ *  the number of thresholds that the distance is above.
+ */
+
+#ifndef TFMPEVENT_H       // Guard to compile only once
+#define TFMPEVENT_H
+
+#include "TFMPI2C.h"
+
+#ifndef TFMP_EVENT_MAX_THRESHOLDS
+#define TFMP_EVENT_MAX_THRESHOLDS   4
+#endif
+
+// Event reason bits
+#define TFMP_EVENT_FIRST       0x01  // first sample after reset
+#define TFMP_EVENT_CHANGE      0x02  // distance moved beyond deadband
+#define TFMP_EVENT_CROSS       0x04  // distance crossed a threshold
+#define TFMP_EVENT_STATUS      0x08  // status changed
+#define TFMP_EVENT_HEARTBEAT   0x10  // heartbeat period over
+
+class TFMPEvent
+{
+  public:
+    // `deadband` in distance units, `heartbeat` in milliseconds.
+    // A heartbeat of zero turns the heartbeat off.
+    TFMPEvent( uint16_t deadband = 0, uint32_t heartbeat = 1000);
+
+    // Add a threshold level.  The distance must rise above
+    // `level + hysteresis` or fall below `level - hysteresis`
+    // to count as a crossing.  Returns `false` if full.
+    bool addThreshold( int16_t level, uint16_t hysteresis);
+    // Look at a sample and decide whether to pass it on.
+    bool check( const TFMPSample &s);
+    // Forget the last sample.  The next one will be passed on.
+    void reset();
+
+    uint8_t reason;          // TFMP_EVENT bits of the last check
+    uint8_t zone;            // thresholds the distance is above
+    uint32_t passed;         // samples passed on
+    uint32_t dropped;        // samples held back
+
+  private:
+    uint16_t deadband;
+    uint32_t heartbeat;      // in microseconds
+    bool first;
+    int16_t lastDist;        // distance of last sample passed on
+    uint8_t lastStatus;
+    uint32_t lastTime;
+
+    uint8_t thresholds;
+    int16_t level[ TFMP_EVENT_MAX_THRESHOLDS];
+    uint16_t hysteresis[ TFMP_EVENT_MAX_THRESHOLDS];
+    uint8_t above;           // one bit for each threshold
+};
+
+#endif
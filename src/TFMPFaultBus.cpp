@@ -0,0 +1,126 @@
+/* File Name: TFMPFaultBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bus fault injection for the TFMPI2C library.
+ *            See `TFMPFaultBus.h` for a description.
+ */
+
+#include "TFMPFaultBus.h"
+
+TFMPFaultBus::TFMPFaultBus( TFMPBus &inner, uint32_t seed)
+  : inner( inner), seed( seed ? seed : 1)
+{
+    clear();
+}
+
+void TFMPFaultBus::clear()
+{
+    stuckFor = 0;
+    stretchMicros = 0;
+    memset( injected, 0, sizeof( injected));
+    memset( chance, 0, sizeof( chance));
+    memset( every, 0, sizeof( every));
+    memset( counter, 0, sizeof( counter));
+    stuck = false;
+    stuckLeft = 0;
+}
+
+void TFMPFaultBus::setChance( uint8_t kind, uint16_t newChance)
+{
+    if( kind < TFMP_FAULT_KINDS) chance[ kind] = newChance;
+}
+
+void TFMPFaultBus::setEvery( uint8_t kind, uint16_t n)
+{
+    if( kind >= TFMP_FAULT_KINDS) return;
+    every[ kind] = n;
+    counter[ kind] = 0;
+}
+
+void TFMPFaultBus::release()
+{
+    stuck = false;
+    stuckLeft = 0;
+}
+
+// Xorshift, which is quick on an 8-bit AVR and repeats
+// the same sequence for the same seed on every machine.
+uint32_t TFMPFaultBus::nextRandom()
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+// True if a fault of this kind should be made now.
+bool TFMPFaultBus::hit( uint8_t kind)
+{
+    bool fault = false;
+    if( every[ kind] && ++counter[ kind] >= every[ kind])
+    {
+      counter[ kind] = 0;
+      fault = true;
+    }
+    if( chance[ kind] && ( nextRandom() % 10000UL) < chance[ kind]) fault = true;
+    if( fault) ++injected[ kind];
+    return fault;
+}
+
+// True if this transfer fails because the bus is stuck.
+bool TFMPFaultBus::stuckTransfer()
+{
+    if( !stuck)
+    {
+      if( !hit( TFMP_FAULT_STUCK)) return false;
+      stuck = true;
+      stuckLeft = stuckFor;
+    }
+    if( stuckLeft && --stuckLeft == 0) stuck = false;
+    return true;
+}
+
+uint8_t TFMPFaultBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    if( stuckTransfer()) return TFMP_BUS_TIMEOUT;
+    if( hit( TFMP_FAULT_NACK)) return TFMP_BUS_NACK_ADDR;
+    if( hit( TFMP_FAULT_STRETCH)) delayMicroseconds( stretchMicros);
+    return inner.write( addr, data, len);
+}
+
+uint8_t TFMPFaultBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    if( stuckTransfer()) return 0;
+    if( hit( TFMP_FAULT_STRETCH)) delayMicroseconds( stretchMicros);
+    uint8_t count = inner.read( addr, data, len);
+    if( count > 0 && hit( TFMP_FAULT_SHORT))
+    {
+      count = nextRandom() % count;
+    }
+    else if( count > 0 && hit( TFMP_FAULT_CORRUPT))
+    {
+      data[ nextRandom() % count] ^= 1 << ( nextRandom() & 7);
+    }
+    return count;
+}
+
+uint32_t TFMPFaultBus::getMicros()
+{
+    return inner.getMicros();
+}
+
+void TFMPFaultBus::wait( uint32_t ms)
+{
+    inner.wait( ms);
+}
+
+void TFMPFaultBus::lock()
+{
+    inner.lock();
+}
+
+void TFMPFaultBus::unlock()
+{
+    inner.unlock();
+}
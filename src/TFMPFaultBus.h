@@ -0,0 +1,90 @@
+/* File Name: TFMPFaultBus.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bus fault injection for the TFMPI2C library.
+ *
+ *  'TFMPFaultBus' wraps around another bus and makes some of its
+ *  transfers go wrong on purpose, so that error handling and retry
+ *  code can be tried out, and so that throughput can be measured with
+ *  a bus that is not perfect.  There are five kinds of fault:
+ *    TFMP_FAULT_NACK     A write is not acknowledged.  The inner bus
+ *                        is not called and the device sees nothing.
+ *    TFMP_FAULT_SHORT    A read passes back fewer bytes than asked.
+ *    TFMP_FAULT_CORRUPT  One bit of one byte read is changed, which
+ *                        shows up as a HEADER or CHECKSUM error.
+ *    TFMP_FAULT_STUCK    The bus is stuck, as if SDA were held low.
+ *                        Every transfer fails with TFMP_BUS_TIMEOUT or
+ *                        no data until `release()` is called, as a bus
+ *                        recovery would, or until `stuckFor` transfers
+ *                        have failed if that is not zero.
+ *    TFMP_FAULT_STRETCH  The device stretches the clock, and the
+ *                        transfer takes `stretchMicros` longer.
+ *
+ *  Each kind can be set to happen at random with `setChance( kind,
+ *  chance)`, where `chance` is in parts per 10000 of the transfers it
+ *  can apply to, or on a schedule with `setEvery( kind, n)`, which makes
+ *  every n-th such transfer fail.  The random numbers come from a
+ *  fixed seed, so that a test run can be repeated exactly.
+ *
+ *  `injected[ kind]` counts the faults of each kind made so far.
+ *  Clear every setting and count with `clear()`.
+ *
+ *  See `extras/TFMPFaultBench` for a host program that measures frames
+ *  per second and recovery time at several error rates.
+ */
+
+#ifndef TFMPFAULTBUS_H       // Guard to compile only once
+#define TFMPFAULTBUS_H
+
+#include "TFMPBus.h"
+
+// Kinds of fault
+#define TFMP_FAULT_NACK      0   // write not acknowledged
+#define TFMP_FAULT_SHORT     1   // read too short
+#define TFMP_FAULT_CORRUPT   2   // one bit of a read changed
+#define TFMP_FAULT_STUCK     3   // bus stuck until released
+#define TFMP_FAULT_STRETCH   4   // transfer slowed
+#define TFMP_FAULT_KINDS     5
+
+class TFMPFaultBus : public TFMPBus
+{
+  public:
+    TFMPFaultBus( TFMPBus &inner, uint32_t seed = 1);
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+    uint32_t getMicros();
+    void wait( uint32_t ms);
+    void lock();
+    void unlock();
+
+    // Chance in parts per 10000, or every n-th transfer.
+    // Zero switches that way of making the fault off.
+    void setChance( uint8_t kind, uint16_t chance);
+    void setEvery( uint8_t kind, uint16_t n);
+
+    uint16_t stuckFor;        // failed transfers before a stuck bus clears itself
+    uint32_t stretchMicros;   // added time of a stretched transfer
+
+    bool isStuck() const { return stuck; }
+    void release();           // free a stuck bus
+    void clear();
+
+    uint32_t injected[ TFMP_FAULT_KINDS];
+
+  private:
+    TFMPBus &inner;
+    uint32_t seed;            // random number state, never zero
+    uint16_t chance[ TFMP_FAULT_KINDS];
+    uint16_t every[ TFMP_FAULT_KINDS];
+    uint16_t counter[ TFMP_FAULT_KINDS];
+    bool stuck;
+    uint16_t stuckLeft;
+
+    uint32_t nextRandom();
+    bool hit( uint8_t kind);
+    bool stuckTransfer();
+};
+
+#endif
@@ -0,0 +1,51 @@
+/* File Name: TFMPHost.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Stand-ins for the few Arduino timing functions used by the
+ *            TFMPI2C library, so that the library can also be compiled
+ *            and run on a Linux host computer.
+ *
+ *  This file is only included if `ARDUINO` is not defined.  On a host
+ *  there is no `Wire` library, so every TFMPI2C object must be given
+ *  a bus, i.e. a `TFMPReplayBus`.
+ */
+
+#ifndef TFMPHOST_H       // Guard to compile only once
+#define TFMPHOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+// Microseconds since an arbitrary start.  Rolls over
+// after about 71 minutes, just like the Arduino.
+inline uint32_t micros()
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts);
+    return uint32_t( uint64_t( ts.tv_sec) * 1000000UL + ts.tv_nsec / 1000);
+}
+
+inline uint32_t millis()
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts);
+    return uint32_t( uint64_t( ts.tv_sec) * 1000UL + ts.tv_nsec / 1000000);
+}
+
+inline void delayMicroseconds( uint32_t us)
+{
+    struct timespec ts;
+    ts.tv_sec = us / 1000000UL;
+    ts.tv_nsec = long( us % 1000000UL) * 1000L;
+    while( nanosleep( &ts, &ts) != 0) {}   // resume if interrupted
+}
+
+inline void delay( uint32_t ms)
+{
+    delayMicroseconds( ms * 1000UL);
+}
+
+#endif
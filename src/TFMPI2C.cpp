@@ -79,15 +79,74 @@
             In our two calls, the final `stopbit` value is changed from
             boolean `true` to literal `1`.  The only effect should be
             to prevent some IDE error messages.
+ * v1.8.0 - 16OCT26 - All I2C transfers now go through a `TFMPBus` object
+            so that bus traffic can be recorded and replayed.  The default
+            bus is `Wire`.  `recoverI2CBus()` and the testing functions
+            are only compiled for an Arduino.
  */
 
 #include <TFMPI2C.h>       //  TFMini-Plus I2C library header
+#include "TFMPDiag.h"      //  Status names for `printFrame()`
+#include "TFMPLog.h"       //  Compile-time log levels
+
+#if defined( TFMP_COMPACT)
+// Buffers shared by every object
+uint8_t TFMPI2C::frame[ TFMP_FRAME_SIZE + 1];
+uint8_t TFMPI2C::reply[ TFMP_REPLY_SIZE + 1];
+uint16_t TFMPI2C::chkSum;
+uint8_t TFMPI2C::replyLen;
+uint8_t TFMPI2C::cmndLen;
+uint8_t TFMPI2C::cmndData[ TFMP_COMMAND_MAX];
+uint8_t TFMPI2C::mmAddr[ 16];
+#endif
+
+#if defined( ARDUINO)
 #include <Wire.h>          //  Arduino I2C/Two-Wire Library
 
+// The default bus shared by every object that is not given another one.
+static TFMPWireBus wireBus( Wire);
+
 // Constructor/Destructor
-TFMPI2C::TFMPI2C(){}
+TFMPI2C::TFMPI2C() : status( TFMP_READY), format( TFMP_FORMAT_CM), bus( &wireBus)
+{
+  #if !defined( TFMP_COMPACT)   // A shared list is already zero.
+    memset( mmAddr, 0, sizeof( mmAddr));
+  #endif
+}
+#endif
+TFMPI2C::TFMPI2C( TFMPBus &bus) : status( TFMP_READY), format( TFMP_FORMAT_CM), bus( &bus)
+{
+  #if !defined( TFMP_COMPACT)
+    memset( mmAddr, 0, sizeof( mmAddr));
+  #endif
+}
 TFMPI2C::~TFMPI2C(){}
 
+size_t TFMPI2C::ramPerSensor()
+{
+    return sizeof( TFMPI2C);
+}
+
+size_t TFMPI2C::ramShared()
+{
+  #if defined( TFMP_COMPACT)
+    return sizeof( frame) + sizeof( reply) + sizeof( chkSum) + sizeof( replyLen) +
+           sizeof( cmndLen) + sizeof( cmndData) + sizeof( mmAddr);
+  #else
+    return 0;
+  #endif
+}
+
+void TFMPI2C::setBus( TFMPBus &newBus)
+{
+    bus = &newBus;
+}
+
+TFMPBus &TFMPI2C::getBus()
+{
+    return *bus;
+}
+
 // = = = = =  GET A FRAME OF DATA FROM THE DEVICE  = = = = = = = = = =
 //
 bool TFMPI2C::getData( int16_t &dist, int16_t &flux, int16_t &temp, uint8_t addr)
@@ -97,27 +156,31 @@ bool TFMPI2C::getData( int16_t &dist, int16_t &flux, int16_t &temp, uint8_t addr
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Step 0 - Command device to ready distance data in centimeters
+    //          or millimeters, as chosen by `setFormat()`
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // The device can also return data in millimeters, but its
-    // resolution is only 5mm (o.5cm) and its accuracy is ±5cm.
-    if( sendCommand( I2C_FORMAT_CM, 0, addr) != true) return false;
+    // This command is the request for a frame, so the format goes
+    // with every request and never has to be switched separately.
+    // In millimeters the resolution is only 5mm (0.5cm) and the
+    // accuracy is still ±5cm.
+    format = getFormat( addr);
+    uint32_t cmnd = ( format == TFMP_FORMAT_MM) ? I2C_FORMAT_MM : I2C_FORMAT_CM;
+    // Hold the bus from the request until the frame is read,
+    // so that no other thread can come between them.
+    TFMPBusLock hold( *bus);
+    if( sendCommand( cmnd, 0, addr) != true) return false;
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Step 1 - Get data from the device.
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Request one data-frame from the slave device address
     // and close the I2C interface.
-    Wire.requestFrom( (int)addr, TFMP_FRAME_SIZE, 1);
-
     memset( frame, 0, sizeof( frame));     // Clear the data-frame buffer.
-    for( uint8_t i = 0; i < TFMP_FRAME_SIZE; i++)
+    uint8_t got = bus->read( addr, frame, TFMP_FRAME_SIZE);
+    TFMP_LOG_BUS( 'R', addr, frame, got, got);
+    if( got != TFMP_FRAME_SIZE)
     {
-      if( Wire.peek() == -1)     // If there is no next byte...
-      {
-        status = TFMP_I2CREAD;   // then set error...
-        return false;            // and return "false."
-      }
-      else frame[ i] = uint8_t( Wire.read());
+      status = TFMP_I2CREAD;     // If any byte is missing, set error...
+      return false;              // and return "false."
     }
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -170,29 +233,84 @@ bool TFMPI2C::getData( int16_t &dist, int16_t &flux, int16_t &temp)
 // Pass back only distance data using given I2C address.
 bool TFMPI2C::getData( int16_t &dist, uint8_t addr)
 {
-  static int16_t flux, temp;
+  int16_t flux, temp;
   return getData( dist, flux, temp, addr);
 }
 
 // Pass back only distance data using default I2C address.
 bool TFMPI2C::getData( int16_t &dist)
 {
-  static int16_t flux, temp;
+  int16_t flux, temp;
   return getData( dist, flux, temp, TFMP_DEFAULT_ADDRESS);
 }
+
+// Pass back a timestamped sample using given I2C address.
+bool TFMPI2C::getData( TFMPSample &s, uint8_t addr)
+{
+  s.time = bus->getMicros();
+  s.count = 1;
+  bool result = getData( s.dist, s.flux, s.temp, addr);
+  s.flags = ( format == TFMP_FORMAT_MM) ? TFMP_SAMPLE_MM : 0;
+  s.status = status;
+  return result;
+}
+
+// Pass back a timestamped sample using default I2C address.
+bool TFMPI2C::getData( TFMPSample &s)
+{
+  return getData( s, TFMP_DEFAULT_ADDRESS);
+}
 //
 // - - - - - - End of Get a Frame of Data  - - - - - - - - - -
 
 
+// = = = = =  DISTANCE FORMAT OF EACH DEVICE  = = = = = = = = = =
+//
+void TFMPI2C::setFormat( uint8_t newFormat, uint8_t addr)
+{
+    addr &= 0x7F;
+    uint8_t bit = 1 << ( addr & 7);
+    if( newFormat == TFMP_FORMAT_MM) mmAddr[ addr >> 3] |= bit;
+      else mmAddr[ addr >> 3] &= ~bit;
+}
+
+void TFMPI2C::setFormat( uint8_t newFormat)
+{
+    setFormat( newFormat, TFMP_DEFAULT_ADDRESS);
+}
+
+uint8_t TFMPI2C::getFormat( uint8_t addr)
+{
+    addr &= 0x7F;
+    return ( mmAddr[ addr >> 3] & ( 1 << ( addr & 7))) ? TFMP_FORMAT_MM : TFMP_FORMAT_CM;
+}
+//
+// - - - - - - -  End of Distance Format  - - - - - - - - - - -
+
+
 // = = = = =  SEND A COMMAND TO THE DEVICE  = = = = = = = = = =0
 //
 // Create a proper command byte array, send the command,
 // get a response, and return the status.
 bool TFMPI2C::sendCommand( uint32_t cmnd, uint32_t param, uint8_t addr)
 {
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // Step 1 - Build the command data to send to the device
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Steps 1 and 2 - Build the command and send it
+    if( sendRequest( cmnd, param, addr) != true) return false;
+
+    // + + + + + + + + + + + + + + + + + + + + + + + + +
+    // If no reply data expected, then go home. Otherwise,
+    // wait for device to process the command and continue.
+    if( replyLen == 0) return true;
+        else bus->wait( TFMP_REPLY_WAIT);
+    // + + + + + + + + + + + + + + + + + + + + + + + + +
+
+    // Steps 3 to 6 - Get the reply and check it
+    return getReply( cmnd, param, addr);
+}
+
+// Build the command data array for `cmnd` and `param`.
+void TFMPI2C::buildCommand( uint32_t cmnd, uint32_t param)
+{
     // `reply` data array, `replyLen`, `cmndLen` and `cmndData`
     // variables are all declared in TFMPI2C.h
 
@@ -227,34 +345,47 @@ bool TFMPI2C::sendCommand( uint32_t cmnd, uint32_t param, uint8_t addr)
     for( uint8_t i = 0; i < ( cmndLen - 1); i++) chkSum += cmndData[ i];
     // and save it as the last byte of command data.
     cmndData[ cmndLen - 1] = uint8_t( chkSum);
+}
+
+// First half of `sendCommand()`: build and send the command
+// but do not wait for a reply.
+bool TFMPI2C::sendRequest( uint32_t cmnd, uint32_t param, uint8_t addr)
+{
+    status = TFMP_READY;    // clear status of any error condition
+
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Step 1 - Build the command data to send to the device
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    buildCommand( cmnd, param);
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Step 2 - Send the command data array to the device
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // Begin transmission to the I2C slave device
-    Wire.beginTransmission( addr);
-    // Queue command data array for transmission to the I2C device
-    if( Wire.write( cmndData, (size_t)cmndLen) != cmndLen)
+    // Transmit the command bytes and a stop message to release the I2C bus.
+    uint8_t err = bus->write( addr, cmndData, cmndLen);
+    TFMP_LOG_BUS( 'W', addr, cmndData, cmndLen, err);
+    if( err == TFMP_BUS_LENGTH)       // If too many bytes for the buffer...
     {
-        status = TFMP_I2CLENGTH;  // then set status code...
-        Wire.write( 0);           // Put a zero in the xmit buffer.
-        Wire.endTransmission( true);   // Send and Close the I2C interface.
-        return false;             // and return "false."
+        status = TFMP_I2CLENGTH;      // then set status code...
+        return false;                 // and return "false."
     }
-
-    // Transmit the bytes and a stop message to release the I2C bus.
-    if( Wire.endTransmission( true) != 0)  // If write error...
+    else if( err != TFMP_BUS_OK)      // If any other write error...
     {
         status = TFMP_I2CWRITE;       // then set status code...
         return false;                 // and return "false."
     }
+    return true;
+}
 
-    // + + + + + + + + + + + + + + + + + + + + + + + + +
-    // If no reply data expected, then go home. Otherwise,
-    // wait for device to process the command and continue.
+// Second half of `sendCommand()`: read the reply to a command
+// sent earlier by `sendRequest()` and check it.  No waiting.
+bool TFMPI2C::getReply( uint32_t cmnd, uint32_t param, uint8_t addr)
+{
+    status = TFMP_READY;    // clear status of any error condition
+
+    // Rebuild the command so that its echo can be checked.
+    buildCommand( cmnd, param);
     if( replyLen == 0) return true;
-        else delay( 500);
-    // + + + + + + + + + + + + + + + + + + + + + + + + +
 
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Step 3 - Get command reply data back from the device.
@@ -266,12 +397,13 @@ bool TFMPI2C::sendCommand( uint32_t cmnd, uint32_t param, uint8_t addr)
 
     // Request reply data from the device and
     // close the I2C interface.
-    Wire.requestFrom( (int)addr, (int)replyLen, 1);
-
     memset( reply, 0, sizeof( reply));   // Clear the reply data buffer.
-    for( uint8_t i = 0; i < replyLen; i++)
+    uint8_t got = bus->read( addr, reply, replyLen);
+    TFMP_LOG_BUS( 'R', addr, reply, got, got);
+    if( got != replyLen)
     {
-      reply[ i] = (uint8_t)Wire.read();
+      status = TFMP_I2CREAD;     // If any byte is missing, set error...
+      return false;              // and return "false."
     }
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -288,6 +420,22 @@ bool TFMPI2C::sendCommand( uint32_t cmnd, uint32_t param, uint8_t addr)
       return false;            // and return "false."
     }
 
+    // Every reply begins with the header, its own length
+    // and the number of the command that it answers.
+    if( reply[ 0] != 0x5A || reply[ 1] != replyLen || reply[ 2] != cmndData[ 2])
+    {
+      status = TFMP_HEADER;    // then set error...
+      return false;            // and return "false."
+    }
+
+    // If the reply should be an echo of the command, check it.
+    if( replyLen == cmndLen &&
+        memcmp( reply, cmndData, cmndLen - 1) != 0)
+    {
+      status = TFMP_ECHO;      // then set error...
+      return false;            // and return "false."
+    }
+
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Step 5 - Interpret different command responses.
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -325,6 +473,191 @@ bool TFMPI2C::sendCommand( uint32_t cmnd, uint32_t param)
 //
 // - - - - - - -  End of Send a Command  - - - - - - - - - - - -
 
+// = = = = = =  FIND ALL DEVICES ON THE BUS  = = = = = = = = =
+//
+// Probe every address from `first` to `last`.  Send a request
+// for the firmware version to every address that acknowledges,
+// all at once, then collect the replies as they become ready.
+// Only a proper firmware version reply counts as a TFMini-Plus.
+// Returns the number of devices put in `list`.
+uint8_t TFMPI2C::discover( TFMPDevice list[], uint8_t maxCount,
+                           uint8_t first, uint8_t last)
+{
+    uint8_t pending[ 16];     // one bit for each address
+    memset( pending, 0, sizeof( pending));
+    uint8_t found = 0;
+    if( last > 127) last = 127;
+
+    // - - Step 1 - Find every address that acknowledges - -
+    for( uint8_t a = first; a <= last; a++)
+    {
+      uint8_t err = bus->write( a, NULL, 0);
+      TFMP_LOG_BUS( 'W', a, NULL, 0, err);
+      if( err == TFMP_BUS_OK)
+      {
+        // - - Step 2 - Ask for the firmware version - -
+        if( sendRequest( GET_FIRMWARE_VERSION, 0, a)) pending[ a >> 3] |= 1 << ( a & 7);
+      }
+    }
+
+    // - - Step 3 - Collect replies until all are in or time is up - -
+    uint32_t start = bus->getMicros();
+    for( ;;)
+    {
+      bool waiting = false;
+      for( uint8_t a = first; a <= last; a++)
+      {
+        uint8_t bit = 1 << ( a & 7);
+        if( ( pending[ a >> 3] & bit) == 0) continue;
+        if( getReply( GET_FIRMWARE_VERSION, 0, a))
+        {
+          pending[ a >> 3] &= ~bit;
+          if( found < maxCount)
+          {
+            list[ found].addr = a;
+            memcpy( list[ found].version, version, 3);
+            ++found;
+          }
+        }
+        else waiting = true;
+      }
+      if( !waiting ||
+          ( bus->getMicros() - start) >= TFMP_DISCOVER_WAIT * 1000UL) break;
+      bus->wait( 1);
+    }
+
+    status = found ? TFMP_READY : TFMP_TIMEOUT;
+    return found;
+}
+//
+// - - - - - - - -  End of Find All Devices  - - - - - - - - - -
+
+// = = = = = =  RESET SEVERAL DEVICES AT ONCE  = = = = = = = = =
+//
+// Resetting devices one at a time with `sendCommand()` costs a
+// reply wait for each.  Here every reset is sent first, and then
+// all devices are polled together, so the whole group takes about
+// as long as one device takes to start.
+// Each device goes through two phases:
+//   1. Waiting for the reply to SOFT_RESET.  A device that has
+//      already gone into reset does not acknowledge, so its reply
+//      is lost, but that is as good as a pass.
+//   2. Waiting for a good data frame, which shows that it is ready.
+// A device may still answer for a moment after the reset with zeros
+// or with its last frame, so no frame is taken until the device has
+// been seen not to acknowledge, i.e. it is restarting, or until
+// TFMP_BOOT_MIN has passed.  Until then no frame is requested either,
+// since a request would also replace a reply that is still to come.
+bool TFMPI2C::isReady( TFMPSample &s, uint8_t addr)
+{
+    // A weak or saturated signal still shows that the device is running.
+    bool good = getData( s, addr) || status == TFMP_WEAK ||
+                status == TFMP_STRONG || status == TFMP_FLOOD;
+    // A frame of zeros also passes the checksum, so look for the header.
+    if( good && ( frame[ 0] != 0x59 || frame[ 1] != 0x59))
+    {
+      status = TFMP_HEADER;
+      s.status = status;
+      good = false;
+    }
+    return good;
+}
+
+uint8_t TFMPI2C::resetAll( const uint8_t addr[], uint8_t count,
+                           uint8_t result[], uint16_t bootWait)
+{
+    uint8_t replyBits[ 16];   // one bit for each device still in phase 1
+    uint8_t readyBits[ 16];   // one bit for each device still in phase 2
+    uint8_t nackBits[ 16];    // one bit for each device seen restarting
+    memset( replyBits, 0, sizeof( replyBits));
+    memset( readyBits, 0, sizeof( readyBits));
+    memset( nackBits, 0, sizeof( nackBits));
+    if( count > 128) count = 128;
+    uint8_t ready = 0;
+    TFMPSample s;
+
+    // - - Step 1 - Send every reset - -
+    for( uint8_t i = 0; i < count; i++)
+    {
+      if( sendRequest( SOFT_RESET, 0, addr[ i]))
+      {
+        replyBits[ i >> 3] |= 1 << ( i & 7);
+        result[ i] = TFMP_TIMEOUT;
+      }
+      else result[ i] = status;
+    }
+
+    // - - Step 2 - Poll until all are ready or time is up - -
+    uint32_t start = bus->getMicros();
+    for( ;;)
+    {
+      bool waiting = false;
+      bool minPassed = ( bus->getMicros() - start) >= TFMP_BOOT_MIN * 1000UL;
+      for( uint8_t i = 0; i < count; i++)
+      {
+        uint8_t bit = 1 << ( i & 7);
+        if( replyBits[ i >> 3] & bit)
+        {
+          if( getReply( SOFT_RESET, 0, addr[ i]))
+          {
+            replyBits[ i >> 3] &= ~bit;
+            readyBits[ i >> 3] |= bit;
+          }
+          else if( status == TFMP_FAIL)
+          {
+            replyBits[ i >> 3] &= ~bit;
+            result[ i] = TFMP_FAIL;
+            continue;
+          }
+          else
+          {
+            // No good reply yet.  A device that does not answer
+            // is restarting, so its reply has been lost.
+            if( status == TFMP_I2CREAD) nackBits[ i >> 3] |= bit;
+            if( minPassed || ( nackBits[ i >> 3] & bit))
+            {
+              replyBits[ i >> 3] &= ~bit;
+              readyBits[ i >> 3] |= bit;
+            }
+            else
+            {
+              waiting = true;
+              continue;
+            }
+          }
+        }
+        if( readyBits[ i >> 3] & bit)
+        {
+          if( !minPassed && ( nackBits[ i >> 3] & bit) == 0)
+          {
+            // Only look for the address, which leaves the device alone.
+            uint8_t err = bus->write( addr[ i], NULL, 0);
+            TFMP_LOG_BUS( 'W', addr[ i], NULL, 0, err);
+            if( err != TFMP_BUS_OK) nackBits[ i >> 3] |= bit;
+            waiting = true;
+          }
+          else if( isReady( s, addr[ i]))
+          {
+            readyBits[ i >> 3] &= ~bit;
+            result[ i] = TFMP_READY;
+            ++ready;
+          }
+          else waiting = true;
+        }
+      }
+      if( !waiting ||
+          ( bus->getMicros() - start) >= bootWait * 1000UL) break;
+      bus->wait( 1);
+    }
+
+    status = ( ready == count) ? TFMP_READY : TFMP_TIMEOUT;
+    if( ready != count) TFMP_LOG_WARN( "resetAll: %u of %u devices ready", ready, count);
+    return ready;
+}
+//
+// - - - - - - - -  End of Reset Several Devices  - - - - - - - - -
+
+#if defined( ARDUINO)
 // = = = = = = =   RECOVER I2C BUS   = = = = = = = = = =
 // An I2C device that quits unexpectedly can leave the I2C bus hung,
 // waiting for a transfer to finish.  This function bypasses the Wire
@@ -368,12 +701,12 @@ void TFMPI2C::recoverI2CBus( uint8_t dataPin, uint8_t clockPin)
 //  defined in every board's 'variants.h` file.
 void TFMPI2C::recoverI2CBus()
 {
-    Serial.println( "Recover default I2C bus.");
+    TFMP_LOG_INFO( "Recover default I2C bus.");
     recoverI2CBus( PIN_WIRE_SDA, PIN_WIRE_SCL);
 
     // If the Arduino has a second I2C interface...
     #if WIRE_INTERFACES_COUNT > 1
-        Serial.println( "Second I2C bus detected.");
+        TFMP_LOG_INFO( "Second I2C bus detected.");
         recoverI2CBus( PIN_WIRE1_SDA, PIN_WIRE1_SCL);
     #endif
 }
@@ -385,58 +718,45 @@ void TFMPI2C::recoverI2CBus()
 // - - - - -   The following are for testing purposes    - - - -
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#if !defined( TFMP_NO_DIAG)
 // Called by either `printFrame()` or `printReply()`
-// Print status condition either `READY` or error type
-void TFMPI2C::printStatus()
+// Format the status condition, either `READY` or error type,
+// and the HEX value of each data byte into one line, then
+// print it with a single `write()`.
+void TFMPI2C::printLine( Print &out, const __FlashStringHelper *label,
+                         const uint8_t data[], uint8_t len)
 {
-    Serial.print(" Status: ");
-    if( status == TFMP_READY)          Serial.print( "READY");
-    else if( status == TFMP_SERIAL)    Serial.print( "SERIAL");
-    else if( status == TFMP_HEADER)    Serial.print( "HEADER");
-    else if( status == TFMP_CHECKSUM)  Serial.print( "CHECKSUM");
-    else if( status == TFMP_TIMEOUT)   Serial.print( "TIMEOUT");
-    else if( status == TFMP_PASS)      Serial.print( "PASS");
-    else if( status == TFMP_FAIL)      Serial.print( "FAIL");
-    else if( status == TFMP_I2CREAD)   Serial.print( "I2C-READ");
-    else if( status == TFMP_I2CWRITE)  Serial.print( "I2C-WRITE");
-    else if( status == TFMP_I2CLENGTH) Serial.print( "I2C-LENGTH");
-    else if( status == TFMP_WEAK)      Serial.print( "Signal weak");
-    else if( status == TFMP_STRONG)    Serial.print( "Signal saturation");
-    else if( status == TFMP_FLOOD)     Serial.print( "Ambient light saturation");
-    else Serial.print( "OTHER");
-   // Serial.println();
+    char line[ 72];      // longest is a frame with the longest status name
+    strcpy_P( line, PSTR( " Status: "));
+    strcat_P( line, (const char *)TFMPStatusName( status));
+    if( label) strcat_P( line, (const char *)label);
+    uint8_t pos = strlen( line);
+    for( uint8_t i = 0; i < len; i++)
+    {
+      uint8_t hi = data[ i] >> 4, lo = data[ i] & 0x0F;
+      line[ pos++] = ' ';
+      line[ pos++] = ( hi < 10) ? '0' + hi : 'A' + hi - 10;
+      line[ pos++] = ( lo < 10) ? '0' + lo : 'A' + lo - 10;
+    }
+    line[ pos++] = '\r';
+    line[ pos++] = '\n';
+    out.write( (const uint8_t *)line, pos);
 }
 
 // Print error type and HEX values
 // of each byte in the data frame
-void TFMPI2C::printFrame()
+void TFMPI2C::printFrame( Print &out)
 {
-    printStatus();
-    // Print the Hex value of each byte of data
-    Serial.print(" Data:");
-    for( uint8_t i = 0; i < TFMP_FRAME_SIZE; i++)
-    {
-      Serial.print(" ");
-      Serial.print( frame[ i] < 16 ? "0" : "");
-      Serial.print( frame[ i], HEX);
-    }
-    Serial.println();
+    printLine( out, F( " Data:"), frame, TFMP_FRAME_SIZE);
 }
 
 // Print error type and HEX values of
 // each byte in the command response frame
-void TFMPI2C::printReply()
+void TFMPI2C::printReply( Print &out)
 {
-    printStatus();
-    // Print the Hex value of each byte
-    for( uint8_t i = 0; i < TFMP_REPLY_SIZE; i++)
-    {
-      Serial.print(" ");
-      Serial.print( reply[ i] < 16 ? "0" : "");
-      Serial.print( reply[ i], HEX);
-    }
-    Serial.println();
+    printLine( out, NULL, reply, TFMP_REPLY_SIZE);
 }
+#endif
 
 // This is Prompt for Y/N response
 bool TFMPI2C::getResponse()
@@ -444,7 +764,7 @@ bool TFMPI2C::getResponse()
     // Five second timer, return `false`
     // if serial read never occurs
     uint32_t serialTimeout = millis() + 5000;
-    static char charIn;
+    char charIn;
     Serial.print("Y/N? ");
     while( Serial.available() || ( millis() <  serialTimeout))
     {
@@ -456,3 +776,4 @@ bool TFMPI2C::getResponse()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#endif  // ARDUINO
@@ -76,12 +76,31 @@
             Corrected some typos in comments.
  * v1.7.2 - 13JAN21 - Eliminated all delays in bus recovery
  * v1.7.3 - 05MAR22 - changed stopbit typecast in call to Wire library
+ * v1.8.0 - 16OCT26 - All I2C transfers go through a `TFMPBus` object.
+            The default bus uses `Wire`.  The library will also compile
+            on a Linux host for use with a replayed bus.
+            Added `TFMPSample` and a `getData( sample, addr)` function.
+            Commands that are answered with an echo now check it.
+            Split `sendCommand()` into `sendRequest()` and `getReply()`.
+            Added `discover()` to find every device on the bus.
+            Added `resetAll()` to reset several devices at once.
+            Added `flags` to `TFMPSample` to mark a repeated frame.
+            Added `setFormat()` for millimeter data from any device.
+            Removed the `static` variables from the short `getData()`
+            functions.  `getData()` holds the bus lock from request
+            to read, so threads with their own objects can share a bus.
+            Added the `TFMP_COMPACT` build option and `ramPerSensor()`.
+            `printFrame()` and `printReply()` print one buffered line
+            to any `Print` object, with status names kept in flash.
+            Messages, such as the one from `recoverI2CBus()`, and a
+            trace of every bus transfer are now chosen by log level,
+            see `TFMPLog.h`.  Nothing is printed by default.
  */
 
 #ifndef TFMPI2C_H       // Guard to compile only once
 #define TFMPI2C_H
 
-#include <Arduino.h>    // Always include this. It's important.
+#include "TFMPBus.h"    // I2C bus interface, includes <Arduino.h>
 
 #define TFMP_DEFAULT_ADDRESS   0x10   // default I2C slave address
                                       // as hexadecimal integer
@@ -91,6 +110,29 @@
 #define TFMP_REPLY_SIZE         8   // Longest command reply = 8 bytes
 #define TFMP_COMMAND_MAX        8   // Longest command = 8 bytes
 
+// Distance format codes, the same as the payload byte
+// of the FORMAT_CM and FORMAT_MM commands.
+#define TFMP_FORMAT_CM        0x01
+#define TFMP_FORMAT_MM        0x06
+
+#define TFMP_REPLY_WAIT       500   // Wait for a command reply in ms
+#define TFMP_DISCOVER_WAIT    100   // Longest wait for discover() replies
+#define TFMP_BOOT_WAIT       1000   // Longest wait for a device to start
+#define TFMP_BOOT_MIN         100   // Shortest time for a device to restart
+
+// Define TFMP_COMPACT for the whole build, i.e. `build_flags = -DTFMP_COMPACT`
+// in PlatformIO, to keep each TFMPI2C object down to a few bytes.  The frame,
+// reply and command buffers and the millimeter address list are then shared
+// by all objects, `status` and `format` are packed into one byte, and the
+// unused `scale` is left out.  With one shared list, `setFormat()` chooses
+// the format for an address on every object and every bus: a device at
+// 0x10 on `Wire` and another at 0x10 on `Wire1` must use the same format.
+// One object can still read every sensor, each in its own format, as
+// `TFMPScheduler` does.  Shared buffers mean that objects must not be
+// used by more than one thread, so `TFMPLockedBus` and `TFMPEngine` will not
+// compile with it.  The sketch must see the same setting as the library, or
+// the objects will be the wrong size.
+
 // Timeout Limits definitions for various functions
 #define TFMP_MAX_READS           20   // readData() sets SERIAL error
 #define MAX_BYTES_BEFORE_HEADER  20   // getData() sets HEADER error
@@ -111,6 +153,7 @@
 #define TFMP_STRONG         11  // Signal Strength saturation
 #define TFMP_FLOOD          12  // Ambient Light saturation
 #define TFMP_MEASURE        13
+#define TFMP_ECHO           14  // reply is not an echo of the command
 
 // Command Definitions
 /* - - - - -  TFMini Plus Data & Command Formats  - - - - -
@@ -199,17 +242,56 @@
 //#define TFMP_LOHI          2  // IO output: near low and far high
 
 
+// One frame of data, or several frames combined, with the
+// time it was read and the status of the read.
+struct TFMPSample
+{
+    uint32_t time;      // bus time in microseconds when read
+    int16_t  dist;      // distance to target
+    int16_t  flux;      // signal strength or quality
+    int16_t  temp;      // chip temperature in degrees Celsius
+    uint8_t  status;    // library status code, TFMP_READY = 0
+    uint8_t  count;     // number of frames in this sample
+    uint8_t  flags;     // TFMP_SAMPLE bits, zero when read
+};
+
+// Sample flag bits
+#define TFMP_SAMPLE_DUP      0x01   // same frame as the last sample
+#define TFMP_SAMPLE_MM       0x02   // distance is in millimeters
+
+// A device found by `discover()`
+struct TFMPDevice
+{
+    uint8_t addr;         // I2C address
+    uint8_t version[ 3];  // firmware version
+};
+
 // Object Class Definitions
+//
+// Every result is passed back in the caller's variables and no
+// function keeps `static` data, but `status`, `version` and the
+// frame buffers belong to the object.  To read from several threads,
+// give each thread its own TFMPI2C object.  They may all share one
+// bus, as long as it is a locking bus such as `TFMPLockedBus`.
 class TFMPI2C
 {
   public:
-    TFMPI2C();
+  #if defined( ARDUINO)
+    TFMPI2C();                 // Use the `Wire` library
+  #endif
+    TFMPI2C( TFMPBus &bus);    // Use any other bus
     ~TFMPI2C();
 
     uint8_t version[ 3];   // three digit firmware version
+  #if defined( TFMP_COMPACT)
+    uint8_t status : 4;    // system error status: READY = 0
+    uint8_t format : 3;    // distance format of the last frame
+  #else
     uint8_t status;        // system error status: READY = 0
-    uint8_t format;        // distance data format: CENTI or MILLI
+    uint8_t format;        // distance format of the last frame:
+                           // TFMP_FORMAT_CM or TFMP_FORMAT_MM
     char scale;            // temperature scale: FAREN or CELSI
+  #endif
 
     // Get a device data-frame and pass back three values
     // using an explicit I2C address
@@ -223,16 +305,72 @@ class TFMPI2C
     // Short version using implied default I2C address
     bool getData( int16_t &dist);
 
+    // Get a device data-frame and pass back a complete sample
+    // with a timestamp and status, using an explicit or implied
+    // default I2C address.
+    bool getData( TFMPSample &s, uint8_t addr);
+    bool getData( TFMPSample &s);
+
     // Send a command, a parameter and an address. Check response.
     bool sendCommand( uint32_t cmnd, uint32_t param, uint8_t addr);
     // Send a command and check response using default address.
     bool sendCommand( uint32_t cmnd, uint32_t param);
 
+    // The two halves of `sendCommand()`, without the wait between.
+    // They allow the replies from several devices to be waited for
+    // at the same time.  `getReply()` must be given the same values
+    // as the `sendRequest()` that it answers.
+    bool sendRequest( uint32_t cmnd, uint32_t param, uint8_t addr);
+    bool getReply( uint32_t cmnd, uint32_t param, uint8_t addr);
+
+    // Find every TFMini-Plus from address `first` to `last` and
+    // pass back its address and firmware version in `list`.
+    // Returns the number of devices found.
+    uint8_t discover( TFMPDevice list[], uint8_t maxCount,
+                      uint8_t first = 1, uint8_t last = 127);
+
+    // Send SOFT_RESET to `count` devices back to back, collect
+    // the replies, then wait for each to send good data frames.
+    // A device whose reply is lost is ready once it sends frames.
+    // No frame counts until the device has been seen restarting,
+    // or until TFMP_BOOT_MIN has passed.
+    // Passes back a status code for each device in `result` and
+    // returns the number that are ready.  `count` is 128 at most.
+    uint8_t resetAll( const uint8_t addr[], uint8_t count, uint8_t result[],
+                      uint16_t bootWait = TFMP_BOOT_WAIT);
+    // True if the device sends a frame with a good header, even one
+    // with a weak or saturated signal.  `s` holds the frame.
+    bool isReady( TFMPSample &s, uint8_t addr);
+
+    // Choose centimeter or millimeter data for one device.  Every
+    // device starts in centimeters.  The choice is kept by this
+    // object, or by all objects with TFMP_COMPACT, and costs nothing
+    // extra when reading.
+    void setFormat( uint8_t newFormat, uint8_t addr);
+    void setFormat( uint8_t newFormat);
+    uint8_t getFormat( uint8_t addr);
+
+    // Change the bus used for all further transfers.
+    void setBus( TFMPBus &newBus);
+    TFMPBus &getBus();
+
+    // Bytes of RAM taken by each object, and by the buffers
+    // that all objects share, which is zero unless TFMP_COMPACT.
+    static size_t ramPerSensor();
+    static size_t ramShared();
+
+  #if defined( ARDUINO)
     //  For testing purposes:
     //  Print status and frame data as string of HEX characters
-    void printFrame();
     //  Print status and command reply data in HEX
-    void printReply();
+    //  Each prints one line to `out`, see `TFMPDiag.h`.
+  #if defined( TFMP_NO_DIAG)
+    void printFrame( Print & = Serial) {}
+    void printReply( Print & = Serial) {}
+  #else
+    void printFrame( Print &out = Serial);
+    void printReply( Print &out = Serial);
+  #endif
     //  Looking for Y/N keyboard input
     bool getResponse();
     //  Recover specified I2C bus
@@ -240,8 +378,23 @@ class TFMPI2C
     //  Recover I2C bus using default pin numbers
     //  Includes second bus, if any
     void recoverI2CBus();
+  #endif
 
   private:
+    TFMPBus *bus;          // all I2C transfers go through this
+
+  #if defined( TFMP_COMPACT)
+    // Shared by all objects.  `getReply()` rebuilds the command
+    // it checks, so a request and reply may still be split.
+    static uint8_t frame[ TFMP_FRAME_SIZE + 1];
+    static uint8_t reply[ TFMP_REPLY_SIZE + 1];
+
+    static uint16_t chkSum;
+    static uint8_t replyLen;
+    static uint8_t cmndLen;
+    static uint8_t cmndData[ TFMP_COMMAND_MAX];
+    static uint8_t mmAddr[ 16];
+  #else
     uint8_t frame[ TFMP_FRAME_SIZE + 1];
     uint8_t reply[ TFMP_REPLY_SIZE + 1];
 
@@ -249,8 +402,15 @@ class TFMPI2C
     uint8_t replyLen;      // store reply data length
     uint8_t cmndLen;       // store command data length
     uint8_t cmndData[ TFMP_COMMAND_MAX]; // store command data
+    uint8_t mmAddr[ 16];   // one bit for each millimeter address
+  #endif
+
+    void buildCommand( uint32_t cmnd, uint32_t param);
 
-    void printStatus();    
+  #if defined( ARDUINO) && !defined( TFMP_NO_DIAG)
+    void printLine( Print &out, const __FlashStringHelper *label,
+                    const uint8_t data[], uint8_t len);
+  #endif
 };
 
 #endif
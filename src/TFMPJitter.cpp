@@ -0,0 +1,100 @@
+/* File Name: TFMPJitter.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Sample timing statistics for the TFMPI2C library.
+ *            See `TFMPJitter.h` for a description.
+ */
+
+#include "TFMPJitter.h"
+
+TFMPJitter::TFMPJitter( uint16_t rate, uint32_t width)
+  : period( 1000000UL / ( rate ? rate : 1))
+{
+    binWidth = width ? width : ( period / 8 ? period / 8 : 1);
+    reset();
+}
+
+void TFMPJitter::reset()
+{
+    count = 0;
+    least = 0xFFFFFFFFUL;
+    most = 0;
+    misses = 0;
+    memset( hist, 0, sizeof( hist));
+    first = true;
+    lastTime = 0;
+    sum = 0;
+    sumSq = 0;
+}
+
+void TFMPJitter::update( const TFMPSample &s)
+{
+    update( s.time);
+}
+
+void TFMPJitter::update( uint32_t time)
+{
+    if( first)
+    {
+      first = false;
+      lastTime = time;
+      return;
+    }
+    uint32_t gap = time - lastTime;
+    lastTime = time;
+
+    ++count;
+    if( gap < least) least = gap;
+    if( gap > most) most = gap;
+    if( gap >= period + period / 2) ++misses;
+
+    // Sum the offsets from the period, not the intervals, so that
+    // the sums stay small however long it runs.
+    uint32_t off = ( gap > period) ? gap - period : period - gap;
+    if( gap > period) sum += off;
+      else sum -= off;
+    sumSq += uint64_t( off) * off;
+
+    // Step through the bins instead of dividing, which is slow on an AVR.
+    uint8_t bin = 0;
+    while( bin < TFMP_JITTER_BINS - 1 && off >= binWidth)
+    {
+      off -= binWidth;
+      ++bin;
+    }
+    ++hist[ bin];
+}
+
+uint32_t TFMPJitter::mean() const
+{
+    if( count == 0) return 0;
+    int64_t half = count / 2;
+    return uint32_t( int64_t( period) +
+                     ( ( sum >= 0) ? sum + half : sum - half) / int64_t( count));
+}
+
+uint32_t TFMPJitter::stdDev() const
+{
+    if( count < 2) return 0;
+    // Variance = ( sumSq - sum * sum / count) / ( count - 1)
+    // With sum = m * count + r, sum * sum / count is worked out as
+    // m * m * count + 2 * m * r + r * r / count, none of which can
+    // overflow, since the first is no more than `sumSq`.
+    int64_t m = sum / int64_t( count);
+    int64_t r = sum - m * int64_t( count);
+    uint64_t ar = ( r < 0) ? uint64_t( -r) : uint64_t( r);
+    uint64_t sq = uint64_t( m * m) * count + uint64_t( 2 * m * r) + ar * ar / count;
+    uint64_t var = ( sumSq > sq) ? ( sumSq - sq) / ( count - 1) : 0;
+
+    // Integer square root, by Newton's method
+    if( var == 0) return 0;
+    uint64_t x = var;
+    uint64_t y = ( x + 1) / 2;
+    while( y < x)
+    {
+      x = y;
+      y = ( x + var / x) / 2;
+    }
+    return uint32_t( x);
+}
@@ -0,0 +1,63 @@
+/* File Name: TFMPJitter.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Sample timing statistics for the TFMPI2C library.
+ *
+ *  A control loop expects its samples evenly spaced.  A `TFMPJitter`
+ *  object, one for each sensor, is given the time of every sample and
+ *  keeps, for the intervals between them:
+ *    - the count, mean, standard deviation, least and greatest,
+ *    - a histogram of how far each interval is from the wanted period,
+ *      in TFMP_JITTER_BINS bins of `binWidth` microseconds, the last bin
+ *      holding everything beyond, and
+ *    - `misses`, the intervals of one and a half periods or more, which
+ *      mean that a read came a whole period late or was skipped.
+ *
+ *  'update( sample)' or 'update( time)' adds one sample.  Each costs a
+ *   few additions and compares and one 64-bit multiply, but no division,
+ *   so it can stay in a finished build.
+ *  'mean()' and 'stdDev()' are worked out only when asked for.
+ *  'reset()' clears everything.
+ */
+
+#ifndef TFMPJITTER_H       // Guard to compile only once
+#define TFMPJITTER_H
+
+#include "TFMPI2C.h"
+
+#ifndef TFMP_JITTER_BINS
+#define TFMP_JITTER_BINS    8
+#endif
+
+class TFMPJitter
+{
+  public:
+    // `rate` is the wanted sample rate in Hz.  `binWidth` is in
+    // microseconds; zero makes it one eighth of the period.
+    TFMPJitter( uint16_t rate = 100, uint32_t binWidth = 0);
+
+    void update( const TFMPSample &s);
+    void update( uint32_t time);
+    void reset();
+
+    uint32_t mean() const;     // mean interval in microseconds
+    uint32_t stdDev() const;   // standard deviation in microseconds
+
+    uint32_t count;            // intervals measured
+    uint32_t least;            // shortest interval
+    uint32_t most;             // longest interval
+    uint32_t misses;           // intervals >= 1.5 periods
+    uint32_t hist[ TFMP_JITTER_BINS];   // |interval - period| by bin
+
+    uint32_t period;           // wanted interval in microseconds
+    uint32_t binWidth;
+
+  private:
+    bool first;
+    uint32_t lastTime;
+    int64_t sum;               // sum of interval - period
+    uint64_t sumSq;            // sum of ( interval - period) squared
+};
+
+#endif
@@ -0,0 +1,159 @@
+/* File Name: TFMPLockedBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Thread-safe bus sharing for the TFMPI2C library
+ *            on a host computer.
+ *            See `TFMPLockedBus.h` for a description.
+ */
+
+// Not built with TFMP_COMPACT, see `TFMPLockedBus.h`.
+#if !defined( ARDUINO) && !defined( TFMP_COMPACT)
+
+#include "TFMPLockedBus.h"
+#include "TFMPLog.h"
+#include <string.h>
+
+// = = = = = = = = = = =  LOCKED BUS  = = = = = = = = = = = = = =
+//
+TFMPLockedBus::TFMPLockedBus( TFMPBus &inner) : inner( inner), depth( 0)
+{
+    memset( &stats, 0, sizeof( stats));
+}
+
+uint8_t TFMPLockedBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    TFMPBusLock hold( *this);
+    return inner.write( addr, data, len);
+}
+
+uint8_t TFMPLockedBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    TFMPBusLock hold( *this);
+    return inner.read( addr, data, len);
+}
+
+uint32_t TFMPLockedBus::getMicros()
+{
+    return inner.getMicros();
+}
+
+// Waits are made without the lock.
+void TFMPLockedBus::wait( uint32_t ms)
+{
+    inner.wait( ms);
+}
+
+void TFMPLockedBus::lock()
+{
+    // Count a wait only if the lock is already held by another thread.
+    // A thread that already holds it gets it again at once, and only
+    // the outermost lock is counted.
+    if( mutex.try_lock())
+    {
+      if( ++depth > 1) return;
+      std::lock_guard< std::mutex> guard( statsMutex);
+      ++stats.locks;
+      return;
+    }
+    uint32_t start = micros();
+    mutex.lock();
+    uint32_t waited = micros() - start;
+    ++depth;
+    std::lock_guard< std::mutex> guard( statsMutex);
+    ++stats.locks;
+    ++stats.contended;
+    stats.waitMicros += waited;
+    if( waited > stats.maxWait) stats.maxWait = waited;
+}
+
+void TFMPLockedBus::unlock()
+{
+    --depth;
+    mutex.unlock();
+}
+
+TFMPLockStats TFMPLockedBus::getStats()
+{
+    std::lock_guard< std::mutex> guard( statsMutex);
+    return stats;
+}
+
+void TFMPLockedBus::clearStats()
+{
+    std::lock_guard< std::mutex> guard( statsMutex);
+    memset( &stats, 0, sizeof( stats));
+}
+//
+// - - - - - - - - - - -  End of Locked Bus  - - - - - - - - - - -
+
+
+#if defined( __linux__)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// = = = = = = = = = = =  LINUX I2C ADAPTER  = = = = = = = = = = = =
+//
+TFMPLinuxBus::TFMPLinuxBus() : fd( -1) {}
+
+TFMPLinuxBus::~TFMPLinuxBus()
+{
+    end();
+}
+
+bool TFMPLinuxBus::begin( const char *device)
+{
+    end();
+    fd = open( device, O_RDWR);
+    if( fd < 0) TFMP_LOG_ERROR( "Cannot open %s", device);
+    return fd >= 0;
+}
+
+void TFMPLinuxBus::end()
+{
+    if( fd >= 0) close( fd);
+    fd = -1;
+}
+
+uint8_t TFMPLinuxBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    if( fd < 0) return TFMP_BUS_OTHER;
+    struct i2c_msg msg;
+    msg.addr = addr;
+    msg.flags = 0;
+    msg.len = len;
+    msg.buf = (uint8_t *)data;
+    struct i2c_rdwr_ioctl_data xfer;
+    xfer.msgs = &msg;
+    xfer.nmsgs = 1;
+    if( ioctl( fd, I2C_RDWR, &xfer) >= 0) return TFMP_BUS_OK;
+    // Adapters do not agree on which error means a NACK.
+    if( errno == ENXIO || errno == EREMOTEIO || errno == EIO) return TFMP_BUS_NACK_ADDR;
+    if( errno == ETIMEDOUT) return TFMP_BUS_TIMEOUT;
+    return TFMP_BUS_OTHER;
+}
+
+uint8_t TFMPLinuxBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    if( fd < 0 || len == 0) return 0;
+    struct i2c_msg msg;
+    msg.addr = addr;
+    msg.flags = I2C_M_RD;
+    msg.len = len;
+    msg.buf = data;
+    struct i2c_rdwr_ioctl_data xfer;
+    xfer.msgs = &msg;
+    xfer.nmsgs = 1;
+    return ( ioctl( fd, I2C_RDWR, &xfer) >= 0) ? len : 0;
+}
+//
+// - - - - - - - - - - -  End of Linux I2C Adapter  - - - - - - - - - -
+
+#endif  // __linux__
+
+#endif  // !ARDUINO
@@ -0,0 +1,93 @@
+/* File Name: TFMPLockedBus.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Thread-safe bus sharing for the TFMPI2C library
+ *            on a host computer.
+ *
+ *  'TFMPLockedBus' wraps any other bus and lets several threads share
+ *  it.  Each thread should use its own TFMPI2C object.  Every transfer
+ *  takes the lock, and `getData()` holds it from the frame request to
+ *  the frame read.  Command reply waits are made without the lock, so
+ *  one thread waiting for a reply does not hold up the others.
+ *
+ *  The lock also keeps count of how often it was taken, not counting
+ *  a nested lock by the thread that already holds it, how often a
+ *  thread had to wait for it, and for how long.  `getStats()` passes
+ *  back a copy of those counts and `clearStats()` sets them to zero.
+ *
+ *  'TFMPLinuxBus' is a bus that uses a Linux I2C adapter such as
+ *  "/dev/i2c-1" through the I2C_RDWR interface.
+ *
+ *  Only for a host computer.  Nothing here is compiled for an Arduino.
+ */
+
+#ifndef TFMPLOCKEDBUS_H       // Guard to compile only once
+#define TFMPLOCKEDBUS_H
+
+#include "TFMPBus.h"
+
+#if !defined( ARDUINO)
+
+#if defined( TFMP_COMPACT)
+  // TFMP_COMPACT objects share one set of buffers, see `TFMPI2C.h`.
+  #error "TFMPLockedBus cannot be used with TFMP_COMPACT."
+#endif
+
+#include <mutex>
+
+// Lock contention counts
+struct TFMPLockStats
+{
+    uint32_t locks;          // times the lock was taken
+    uint32_t contended;      // times a thread had to wait for it
+    uint64_t waitMicros;     // total time spent waiting
+    uint32_t maxWait;        // longest single wait in microseconds
+};
+
+class TFMPLockedBus : public TFMPBus
+{
+  public:
+    TFMPLockedBus( TFMPBus &inner);
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+    uint32_t getMicros();
+    void wait( uint32_t ms);
+    void lock();
+    void unlock();
+
+    TFMPLockStats getStats();
+    void clearStats();
+
+  private:
+    TFMPBus &inner;
+    std::recursive_mutex mutex;
+    uint32_t depth;          // nested locks, only changed with `mutex` held
+    std::mutex statsMutex;
+    TFMPLockStats stats;
+};
+
+#if defined( __linux__)
+class TFMPLinuxBus : public TFMPBus
+{
+  public:
+    TFMPLinuxBus();
+    ~TFMPLinuxBus();
+
+    // Open an adapter such as "/dev/i2c-1".  Returns `false` if it
+    // cannot be opened.
+    bool begin( const char *device);
+    void end();
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+
+  private:
+    int fd;
+};
+#endif  // __linux__
+
+#endif  // !ARDUINO
+
+#endif
@@ -0,0 +1,88 @@
+/* File Name: TFMPLog.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Compile-time log levels for the TFMPI2C library.
+ *            See `TFMPLog.h` for a description.
+ */
+
+#include "TFMPLog.h"
+
+#if TFMP_LOG_LEVEL > TFMP_LEVEL_NONE
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#if defined( ARDUINO)
+static Print *logOut = &Serial;
+
+void TFMPLogOutput( Print &out)
+{
+    logOut = &out;
+}
+#endif
+
+// Hand one finished line to the output in a single write.
+static void logLine( char line[], uint8_t len)
+{
+  #if defined( ARDUINO)
+    line[ len++] = '\r';
+    line[ len++] = '\n';
+    logOut->write( (const uint8_t *)line, len);
+  #else
+    line[ len++] = '\n';
+    fwrite( line, 1, len, stderr);
+  #endif
+}
+
+void TFMPLogWrite( char level, const char *fmt, ...)
+{
+    char line[ TFMP_LOG_LINE + 2];    // room for the line end
+    line[ 0] = level;
+    line[ 1] = ':';
+    line[ 2] = ' ';
+    va_list args;
+    va_start( args, fmt);
+  #if defined( __AVR__)
+    int len = vsnprintf_P( &line[ 3], TFMP_LOG_LINE - 3, fmt, args);
+  #else
+    int len = vsnprintf( &line[ 3], TFMP_LOG_LINE - 3, fmt, args);
+  #endif
+    va_end( args);
+    if( len < 0) len = 0;
+    if( len > TFMP_LOG_LINE - 4) len = TFMP_LOG_LINE - 4;   // cut off
+    logLine( line, uint8_t( len + 3));
+}
+
+// One bus transfer: kind, address, direction, data and result.
+void TFMPLogBus( char kind, uint8_t addr, const uint8_t *data,
+                 uint8_t len, uint8_t result)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char line[ TFMP_LOG_LINE + 2];
+    uint8_t pos = 0;
+    line[ pos++] = 'T';
+    line[ pos++] = ':';
+    line[ pos++] = ' ';
+    line[ pos++] = kind;
+    line[ pos++] = ' ';
+    line[ pos++] = hex[ addr >> 4];
+    line[ pos++] = hex[ addr & 0x0F];
+    line[ pos++] = ' ';
+    line[ pos++] = ( kind == 'W') ? '<' : '>';
+    for( uint8_t i = 0; i < len && pos + 9 <= TFMP_LOG_LINE; i++)
+    {
+      line[ pos++] = ' ';
+      line[ pos++] = hex[ data[ i] >> 4];
+      line[ pos++] = hex[ data[ i] & 0x0F];
+    }
+    line[ pos++] = ' ';
+    line[ pos++] = '=';
+    line[ pos++] = ' ';
+    if( result >= 100) line[ pos++] = '0' + result / 100;
+    if( result >= 10) line[ pos++] = '0' + ( result / 10) % 10;
+    line[ pos++] = '0' + result % 10;
+    logLine( line, pos);
+}
+
+#endif
@@ -0,0 +1,97 @@
+/* File Name: TFMPLog.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Compile-time log levels for the TFMPI2C library.
+ *
+ *  The library reports what it is doing through four macros, from
+ *  the most to the least important:
+ *    TFMP_LOG_ERROR( fmt, ...)   something failed that should not
+ *    TFMP_LOG_WARN( fmt, ...)    something odd that was handled
+ *    TFMP_LOG_INFO( fmt, ...)    a rare event, such as a bus recovery
+ *    TFMP_LOG_TRACE( fmt, ...)   every small step
+ *  and `TFMP_LOG_BUS( kind, addr, data, len, result)`, which traces
+ *  every I2C write ('W') and read ('R') with its bytes in HEX.
+ *
+ *  Choose the level for the whole build by defining TFMP_LOG_LEVEL as
+ *  one of the TFMP_LEVEL values below, i.e. `build_flags =
+ *  -DTFMP_LOG_LEVEL=3` in PlatformIO for INFO.  Every level above it
+ *  becomes an empty statement: its arguments are not evaluated, and
+ *  its format string is not compiled in.  The default is NONE, so a
+ *  production build pays nothing at all.
+ *
+ *  On an Arduino, messages go to `Serial` unless another `Print`
+ *  object is given to `TFMPLogOutput()`.  The format string is kept in
+ *  flash.  An AVR `printf` has no floating point, so use integers.  On
+ *  a host computer, messages go to `stderr`.
+ *
+ *  Each message is one line that begins with the level letter, i.e.
+ *    I: Recover default I2C bus.
+ *    T: W 10 < 5A 05 00 01 60 = 0
+ *    T: R 10 > 59 59 64 00 F4 01 08 09 0C = 9
+ */
+
+#ifndef TFMPLOG_H       // Guard to compile only once
+#define TFMPLOG_H
+
+#include "TFMPBus.h"
+
+#define TFMP_LEVEL_NONE     0
+#define TFMP_LEVEL_ERROR    1
+#define TFMP_LEVEL_WARN     2
+#define TFMP_LEVEL_INFO     3
+#define TFMP_LEVEL_TRACE    4
+
+#ifndef TFMP_LOG_LEVEL
+#define TFMP_LOG_LEVEL      TFMP_LEVEL_NONE
+#endif
+
+#ifndef TFMP_LOG_LINE
+#define TFMP_LOG_LINE      80   // longest line, including the level letter
+#endif
+
+#if TFMP_LOG_LEVEL > TFMP_LEVEL_NONE
+  #if defined( ARDUINO)
+    void TFMPLogOutput( Print &out);
+    #define TFMP_LOG_STR( s)  PSTR( s)
+  #else
+    #define TFMP_LOG_STR( s)  ( s)
+  #endif
+  // `fmt` is in flash on an Arduino.
+  void TFMPLogWrite( char level, const char *fmt, ...);
+  void TFMPLogBus( char kind, uint8_t addr, const uint8_t *data,
+                   uint8_t len, uint8_t result);
+#endif
+
+#define TFMP_LOG_NOTHING   do {} while( 0)
+
+#if TFMP_LOG_LEVEL >= TFMP_LEVEL_ERROR
+  #define TFMP_LOG_ERROR( fmt, ...) TFMPLogWrite( 'E', TFMP_LOG_STR( fmt), ##__VA_ARGS__)
+#else
+  #define TFMP_LOG_ERROR( fmt, ...) TFMP_LOG_NOTHING
+#endif
+
+#if TFMP_LOG_LEVEL >= TFMP_LEVEL_WARN
+  #define TFMP_LOG_WARN( fmt, ...)  TFMPLogWrite( 'W', TFMP_LOG_STR( fmt), ##__VA_ARGS__)
+#else
+  #define TFMP_LOG_WARN( fmt, ...)  TFMP_LOG_NOTHING
+#endif
+
+#if TFMP_LOG_LEVEL >= TFMP_LEVEL_INFO
+  #define TFMP_LOG_INFO( fmt, ...)  TFMPLogWrite( 'I', TFMP_LOG_STR( fmt), ##__VA_ARGS__)
+#else
+  #define TFMP_LOG_INFO( fmt, ...)  TFMP_LOG_NOTHING
+#endif
+
+#if TFMP_LOG_LEVEL >= TFMP_LEVEL_TRACE
+  #define TFMP_LOG_TRACE( fmt, ...) TFMPLogWrite( 'T', TFMP_LOG_STR( fmt), ##__VA_ARGS__)
+  #define TFMP_LOG_BUS( kind, addr, data, len, result) \
+            TFMPLogBus( kind, addr, data, len, result)
+#else
+  #define TFMP_LOG_TRACE( fmt, ...) TFMP_LOG_NOTHING
+  // `sizeof` marks the result as used without evaluating anything.
+  #define TFMP_LOG_BUS( kind, addr, data, len, result) \
+            do { (void)sizeof( result); } while( 0)
+#endif
+
+#endif
@@ -0,0 +1,121 @@
+/* File Name: TFMPOversample.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Oversampling and decimation for the TFMPI2C library.
+ *            See `TFMPOversample.h` for a description.
+ */
+
+#include "TFMPOversample.h"
+
+TFMPOversample::TFMPOversample( TFMPI2C &tfm, uint8_t addr)
+  : errors( 0), tfm( tfm), addr( addr), mode( TFMP_MEAN),
+    framePeriod( 10000), outPeriod( 100000), nextFrame( 0), nextOut( 0)
+{
+    clear();
+}
+
+bool TFMPOversample::begin( uint16_t frameRate, uint16_t outputRate, uint8_t mode)
+{
+    this->mode = mode;
+    if( frameRate == 0) frameRate = FRAME_100;
+    if( outputRate == 0 || outputRate > frameRate) outputRate = frameRate;
+    framePeriod = 1000000UL / frameRate;
+    outPeriod = 1000000UL / outputRate;
+
+    bool result = tfm.sendCommand( SET_FRAME_RATE, frameRate, addr);
+
+    clear();
+    errors = 0;
+    nextFrame = tfm.getBus().getMicros();
+    nextOut = nextFrame + outPeriod;
+    return result;
+}
+
+void TFMPOversample::clear()
+{
+    count = 0;
+    lastStatus = TFMP_READY;
+    lastTime = 0;
+    sumDist = 0;
+    sumFlux = 0;
+    sumTemp = 0;
+}
+
+// Median of the distances kept, by insertion sort of a copy.
+// At most TFMP_OVERSAMPLE_MAX values, so this is quick enough.
+int16_t TFMPOversample::median()
+{
+    uint8_t n = ( count < TFMP_OVERSAMPLE_MAX) ? count : TFMP_OVERSAMPLE_MAX;
+    int16_t v[ TFMP_OVERSAMPLE_MAX];
+    for( uint8_t i = 0; i < n; i++)
+    {
+      int16_t x = dists[ i];
+      uint8_t j = i;
+      while( j > 0 && v[ j - 1] > x)
+      {
+        v[ j] = v[ j - 1];
+        --j;
+      }
+      v[ j] = x;
+    }
+    return v[ n / 2];
+}
+
+bool TFMPOversample::update( TFMPSample &s)
+{
+    uint32_t now = tfm.getBus().getMicros();
+
+    // - - Read a frame if one is due - -
+    if( int32_t( now - nextFrame) >= 0)
+    {
+      TFMPSample f;
+      if( count == 255) {}     // Sample is full, so skip this frame.
+      else if( tfm.getData( f, addr))
+      {
+        dists[ count % TFMP_OVERSAMPLE_MAX] = f.dist;
+        sumDist += f.dist;
+        sumFlux += f.flux;
+        sumTemp += f.temp;
+        lastTime = f.time;
+        ++count;
+      }
+      else
+      {
+        lastStatus = f.status;
+        ++errors;
+      }
+      nextFrame += framePeriod;
+      // If more than a frame behind, start again from now.
+      if( int32_t( now - nextFrame) >= int32_t( framePeriod)) nextFrame = now + framePeriod;
+    }
+
+    // - - Pass back a sample if the output period is over - -
+    if( int32_t( now - nextOut) < 0) return false;
+    nextOut += outPeriod;
+    if( int32_t( now - nextOut) >= int32_t( outPeriod)) nextOut = now + outPeriod;
+
+    s.count = count;
+    s.flags = ( tfm.getFormat( addr) == TFMP_FORMAT_MM) ? TFMP_SAMPLE_MM : 0;
+    if( count == 0)
+    {
+      s.time = now;
+      s.status = lastStatus;
+      s.dist = 0;
+      s.flux = 0;
+      s.temp = 0;
+    }
+    else
+    {
+      s.time = lastTime;
+      s.status = TFMP_READY;
+      // Round to nearest rather than toward zero.
+      int16_t half = count / 2;
+      s.dist = ( mode == TFMP_MEDIAN) ? median()
+             : int16_t( ( sumDist + ( sumDist < 0 ? -half : half)) / count);
+      s.flux = int16_t( ( sumFlux + ( sumFlux < 0 ? -half : half)) / count);
+      s.temp = int16_t( ( sumTemp + ( sumTemp < 0 ? -half : half)) / count);
+    }
+    clear();
+    return true;
+}
@@ -0,0 +1,78 @@
+/* File Name: TFMPOversample.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Oversampling and decimation for the TFMPI2C library.
+ *
+ *  The device can measure at up to 1000 frames per second, but most
+ *  applications want far fewer samples than that.  A `TFMPOversample`
+ *  object sets a high device frame-rate, reads every frame as it comes
+ *  due, and passes back one averaged (mean) or median sample at a lower
+ *  output rate.  The sample `count` tells how many good frames went into
+ *  it.  Noise falls roughly with the square root of that count.
+ *
+ *  'begin( frameRate, outputRate, mode)'
+ *   Sends SET_FRAME_RATE to the device and sets the output rate in Hz.
+ *   `mode` is TFMP_MEAN or TFMP_MEDIAN.  Returns the result of the
+ *   command.  The frame rate is not saved in the device.
+ *
+ *  'update( sample)'
+ *   Call as often as possible from the main loop.  It reads a frame
+ *   only when one is due and returns `true` when an output sample is
+ *   ready.  If no good frame was read in the output period, the sample
+ *   `count` is zero, its `status` is that of the last failed read, and
+ *   its distance, flux and temperature are zero.
+ *
+ *  NOTE: At the standard 100KHz bus clock a frame read takes about 1.5ms,
+ *  so 1000 frames per second is only possible with a 400KHz bus.  Frames
+ *  that are missed simply lower the sample count.
+ */
+
+#ifndef TFMPOVERSAMPLE_H       // Guard to compile only once
+#define TFMPOVERSAMPLE_H
+
+#include "TFMPI2C.h"
+
+// Frames kept for the median.  If there are more frames
+// in an output period, the median of the latest is used.
+#ifndef TFMP_OVERSAMPLE_MAX
+#define TFMP_OVERSAMPLE_MAX   16
+#endif
+
+// Decimation modes
+#define TFMP_MEAN     0
+#define TFMP_MEDIAN   1
+
+class TFMPOversample
+{
+  public:
+    TFMPOversample( TFMPI2C &tfm, uint8_t addr = TFMP_DEFAULT_ADDRESS);
+
+    bool begin( uint16_t frameRate, uint16_t outputRate, uint8_t mode = TFMP_MEAN);
+    bool update( TFMPSample &s);
+
+    uint32_t errors;        // count of failed frame reads
+
+  private:
+    TFMPI2C &tfm;
+    uint8_t addr;
+    uint8_t mode;
+    uint32_t framePeriod;   // microseconds between frame reads
+    uint32_t outPeriod;     // microseconds between output samples
+    uint32_t nextFrame;     // time of next frame read
+    uint32_t nextOut;       // time of next output sample
+
+    // Accumulated frames of this output period
+    uint8_t count;
+    uint8_t lastStatus;
+    uint32_t lastTime;
+    int32_t sumDist;
+    int32_t sumFlux;
+    int32_t sumTemp;
+    int16_t dists[ TFMP_OVERSAMPLE_MAX];
+
+    void clear();
+    int16_t median();
+};
+
+#endif
@@ -0,0 +1,145 @@
+/* File Name: TFMPPhase.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Frame phase tracking for the TFMPI2C library.
+ *            See `TFMPPhase.h` for a description.
+ */
+
+#include "TFMPPhase.h"
+
+TFMPPhase::TFMPPhase( uint16_t frameRate, uint16_t minStep)
+  : dup( frameRate, 1500000UL / ( frameRate ? frameRate : 1)),
+    nominal( 1000000UL / ( frameRate ? frameRate : 1)),
+    minStep( minStep ? minStep : 1)
+{
+    reset();
+}
+
+void TFMPPhase::reset()
+{
+    dup.reset();
+    nextPoll = 0;
+    age = 0;
+    locked = false;
+    started = false;
+    lo = 0;
+    hi = 0;
+    landed = 0;
+    period = nominal << 8;
+    frac = 0;
+    anchored = false;
+    anchor = 0;
+    frames = 0;
+    relax = minStep / 8 ? minStep / 8 : 1;
+    seen = false;
+}
+
+bool TFMPPhase::due( uint32_t now) const
+{
+    return !started || int32_t( now - nextPoll) >= 0;
+}
+
+// Device clock error in parts per million, more than zero if slow.
+int32_t TFMPPhase::drift() const
+{
+    return int32_t( ( int64_t( period) - int64_t( nominal << 8)) * 1000000L /
+                    int64_t( nominal << 8));
+}
+
+// Read in the middle of the window until it is narrow, then at the top.
+void TFMPPhase::schedule()
+{
+    uint32_t width = hi - lo;
+    locked = ( width <= minStep);
+    nextPoll = locked ? hi : lo + width / 2;
+}
+
+// Move the window ahead by one measured frame period.  The
+// fraction of a microsecond is carried over to the next step.
+void TFMPPhase::advance()
+{
+    uint32_t step = frac + period;
+    frac = step & 0xFF;
+    lo += step >> 8;
+    hi += step >> 8;
+    ++frames;
+}
+
+bool TFMPPhase::update( TFMPSample &s)
+{
+    uint32_t t = s.time;
+    bool wasLocked = locked;
+    bool isNew = dup.check( s);
+    if( ( s.flags & TFMP_SAMPLE_DUP) == 0 && !isNew) return false;  // bad read
+
+    // - - First frame, nothing is known but that it landed by now - -
+    if( !started)
+    {
+      if( !isNew) return false;
+      started = true;
+      landed = t;
+      age = 0;
+      lo = t;
+      hi = t + ( period >> 8);
+      schedule();
+      return true;
+    }
+
+    if( isNew)
+    {
+      // If frames were missed, move the window ahead whole periods.
+      while( int32_t( t - hi) >= int32_t( period >> 8)) advance();
+      // Landed after `lo` and no later than now.
+      if( int32_t( t - hi) < 0) hi = t;
+      if( int32_t( hi - lo) < 0) lo = hi;
+      landed = lo + ( hi - lo) / 2;
+      age = int32_t( t - landed) > 0 ? t - landed : 0;
+
+      // - - Measure the device frame period - -
+      // Only a landing time known to within `minStep` is used.  The
+      // first one is the anchor, and later ones give the period over
+      // all the frames since, which follows a slow or fast device
+      // clock far more closely than any one frame could.
+      if( hi - lo <= minStep)
+      {
+        if( !anchored || frames >= TFMP_PHASE_SPAN)
+        {
+          anchored = true;
+          anchor = landed;
+          frames = 0;
+        }
+        else if( frames >= TFMP_PHASE_SPAN / 16)
+        {
+          uint32_t p = uint32_t( ( uint64_t( landed - anchor) << 8) / frames);
+          // Ignore anything more than 1/16 from the frame-rate.
+          uint32_t limit = nominal << 4;
+          if( p > ( nominal << 8) - limit && p < ( nominal << 8) + limit) period = p;
+        }
+      }
+
+      // - - Window for the next frame, a little wider at the bottom - -
+      // A read in the middle of the window that finds a new frame,
+      // with no repeat before it, may have missed one that landed
+      // below `lo`, so the window is widened twice as much next time.
+      // Once the landing is found between two reads, widen by little.
+      uint32_t base = minStep / 8 ? minStep / 8 : 1;
+      if( seen) relax = base;
+        else if( !wasLocked && relax < ( period >> 10)) relax *= 2;
+      seen = false;
+      advance();
+      lo -= relax;
+    }
+    else
+    {
+      seen = true;
+      age = t - landed;
+      // Not landed yet, so it lands after now.
+      if( int32_t( t - lo) > 0) lo = t;
+      // If it is later than the whole window, the clock has drifted
+      // the other way.  Open the window upward again.
+      if( int32_t( hi - lo) <= 0) hi = lo + 2 * minStep;
+    }
+    schedule();
+    return isNew;
+}
@@ -0,0 +1,89 @@
+/* File Name: TFMPPhase.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Frame phase tracking for the TFMPI2C library.
+ *
+ *  The device makes a new frame on its own clock.  A read made at the
+ *  same rate, but on the Arduino's clock, can come at any time between
+ *  one new frame and the next, so the age of the data wanders between
+ *  zero and a whole frame period.
+ *
+ *  A `TFMPPhase` object, one for each sensor, finds when each frame
+ *  lands and times the reads to come just after it.  It keeps a window,
+ *  `lo` to `hi`, in which the next frame should land:
+ *    - A new frame read at time t landed no later than t,
+ *      so `hi` moves down to t.
+ *    - A repeated frame read at time t has not landed yet,
+ *      so `lo` moves up to t, and the frame is read again.
+ *  While the window is wider than `minStep`, reads are made in the
+ *  middle of it, which halves it each time.  Once it is narrower,
+ *  `locked` is `true` and reads are made at `hi`, just after the frame
+ *  lands.
+ *
+ *  The device clock is never quite the same as the Arduino clock, so
+ *  the frame period is measured from the landing times over many
+ *  frames, and the window moves ahead by that period, not the nominal
+ *  one.  `drift()` gives the difference in parts per million.  Each
+ *  frame the window is also widened a little at the low end, so that
+ *  now and then a read in the middle catches any error left over.
+ *
+ *  Read at `nextPoll`, or whenever `due()` is true, and pass every
+ *  sample to `update()`.  'age' is then the estimated time in micro-
+ *  seconds from the moment that the frame landed to the moment that it
+ *  was read.
+ *
+ *  Repeated frames are found with a `TFMPDuplicate`, so `update()` also
+ *  sets the TFMP_SAMPLE_DUP bit in the sample `flags`.  A locked read
+ *  comes one period after the last new frame, so here a match counts
+ *  as a repeat for up to one and a half periods, not one.  A target so
+ *  still that the distance, flux and temperature all stay the same
+ *  will upset the tracking until they change.
+ */
+
+#ifndef TFMPPHASE_H       // Guard to compile only once
+#define TFMPPHASE_H
+
+#include "TFMPDuplicate.h"
+
+#define TFMP_PHASE_STEP       50   // narrowest window in microseconds
+#define TFMP_PHASE_SPAN      256   // frames over which the period is measured
+
+class TFMPPhase
+{
+  public:
+    // `frameRate` is the device frame-rate in Hz, and must not be zero.
+    TFMPPhase( uint16_t frameRate = 100, uint16_t minStep = TFMP_PHASE_STEP);
+
+    // Pass in every sample read.  Returns `true` if it is a new frame.
+    bool update( TFMPSample &s);
+    // True when it is time to read again.
+    bool due( uint32_t now) const;
+    void reset();
+    // Device clock error in parts per million, more than zero if slow.
+    int32_t drift() const;
+
+    uint32_t nextPoll;       // bus time of the next read
+    uint32_t age;            // age of the last sample in microseconds
+    bool locked;             // landing time known to within `minStep`
+    TFMPDuplicate dup;       // new and repeated frame counts
+
+  private:
+    uint32_t nominal;        // frame period in microseconds from the rate
+    uint16_t minStep;
+    uint32_t period;         // measured period in 1/256 microseconds
+    uint8_t frac;            // fraction of a microsecond carried over
+    bool anchored;
+    uint32_t anchor;         // landing time the period is measured from
+    uint16_t frames;         // frames since the anchor
+    uint32_t relax;          // widen the window this much each frame
+    bool seen;               // a repeat was read since the last new frame
+    bool started;
+    uint32_t lo, hi;         // next frame lands after `lo`, by `hi`
+    uint32_t landed;         // estimated time the last frame landed
+
+    void schedule();
+    void advance();
+};
+
+#endif
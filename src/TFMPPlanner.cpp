@@ -0,0 +1,217 @@
+/* File Name: TFMPPlanner.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bus time budget planning for the TFMPI2C library.
+ *            See `TFMPPlanner.h` for a description.
+ */
+
+#include "TFMPPlanner.h"
+
+TFMPPlanner::TFMPPlanner( uint32_t busClock, uint16_t overhead, uint8_t load)
+  : utilization( 0), overloaded( false), sensors( 0),
+    load( load > 100 ? 100 : load)
+{
+    if( busClock == 0) busClock = 100000UL;
+    read = ( TFMP_PLAN_CLOCKS * 1000000UL + busClock - 1) / busClock + overhead;
+}
+
+int8_t TFMPPlanner::add( uint8_t addr, uint16_t wanted, uint16_t frameRate)
+{
+    if( sensors >= TFMP_SCHED_MAX_SENSORS) return -1;
+    Entry &e = entry[ sensors];
+    e.addr = addr;
+    e.wanted = wanted;
+    e.frameRate = frameRate;
+    e.rate = 0;
+    e.period = 0;
+    e.shift = 0;
+    e.offset = 0;
+    return sensors++;
+}
+
+uint16_t TFMPPlanner::capacity() const
+{
+    return uint16_t( uint32_t( load) * 10000UL / read);
+}
+
+bool TFMPPlanner::plan()
+{
+    share();
+    harmonic();
+    bool fits = slots();
+
+    bool all = true;
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      if( entry[ i].rate < entry[ i].wanted) all = false;
+    }
+    uint32_t used = busUse();
+    uint32_t percent = ( used + 50) / 100;
+    utilization = ( percent > 255) ? 255 : uint8_t( percent);
+    overloaded = !fits || used > uint32_t( load) * 100;
+    return all && !overloaded;
+}
+
+// Bus time used by the plan in hundredths of a percent
+uint32_t TFMPPlanner::busUse() const
+{
+    uint32_t used = 0;
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      used += read * 10000UL / entry[ i].period;
+    }
+    return used;
+}
+
+// Share out the bus, least demand first.  Each pass gives every sensor
+// that wants no more than an equal share all that it wants.  When none
+// is left that does, the rest split what remains equally.
+void TFMPPlanner::share()
+{
+    uint32_t left = capacity();   // reads a second not yet given out
+    uint8_t open = sensors;       // sensors not yet given a rate
+    for( uint8_t i = 0; i < sensors; i++) entry[ i].rate = 0;
+
+    while( open)
+    {
+      uint32_t share = left / open;
+      bool gave = false;
+      for( uint8_t i = 0; i < sensors; i++)
+      {
+        Entry &e = entry[ i];
+        if( e.rate) continue;
+        // No more than the device frame-rate, and at least one.
+        uint16_t want = ( e.wanted < e.frameRate) ? e.wanted : e.frameRate;
+        if( want == 0) want = 1;
+        if( want <= share)
+        {
+          e.rate = want;
+          left -= e.rate;
+          --open;
+          gave = true;
+        }
+      }
+      if( gave) continue;
+      // Even one read a second each may be more than the bus has.
+      // That shows up as `overloaded` at the end of `plan()`.
+      for( uint8_t i = 0; i < sensors; i++)
+      {
+        if( entry[ i].rate == 0) entry[ i].rate = share ? uint16_t( share) : 1;
+      }
+      open = 0;
+    }
+}
+
+// Round every rate to a period that is the minor cycle, the period of
+// the fastest sensor, times a power of two.
+void TFMPPlanner::harmonic()
+{
+    uint16_t top = 0;
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      if( entry[ i].rate > top) top = entry[ i].rate;
+    }
+    if( top == 0) return;
+    uint32_t minor = 1000000UL / top;
+
+    uint16_t shared[ TFMP_SCHED_MAX_SENSORS];
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      Entry &e = entry[ i];
+      shared[ i] = e.rate;
+      // The longest harmonic period that is no longer than the
+      // shared rate's, so the rate is rounded up...
+      uint32_t target = 1000000UL / e.rate;
+      uint8_t k = 0;
+      while( ( minor << ( k + 1)) <= target) ++k;
+      // ...but not past the device frame-rate.
+      if( 1000000UL / ( minor << k) > e.frameRate) ++k;
+      e.shift = k;
+      e.period = minor << k;
+    }
+
+    // Rounding up can ask too much of the bus.  If so, round down the
+    // fastest of the sensors that were rounded up until it fits.
+    while( busUse() > uint32_t( load) * 100)
+    {
+      int8_t fastest = -1;
+      for( uint8_t i = 0; i < sensors; i++)
+      {
+        const Entry &e = entry[ i];
+        if( 1000000UL / e.period <= shared[ i]) continue;
+        if( fastest < 0 || e.period < entry[ fastest].period) fastest = i;
+      }
+      if( fastest < 0) break;
+      ++entry[ fastest].shift;
+      entry[ fastest].period <<= 1;
+    }
+
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      entry[ i].rate = uint16_t( 1000000UL / entry[ i].period);
+    }
+}
+
+// Give each sensor a fixed slot, one read long, in the minor cycles of
+// a major cycle 32 minor cycles long.  The fastest sensors go first, and
+// a sensor with a period of 2^k minor cycles takes the same slot in every
+// 2^k-th minor cycle.  Returns `false` if a sensor could not be given a
+// slot of its own.
+bool TFMPPlanner::slots()
+{
+    if( sensors == 0) return true;
+    uint32_t minor = entry[ 0].period >> entry[ 0].shift;
+    uint32_t count = minor / read;          // slots in a minor cycle
+    if( count > sensors) count = sensors;   // no more are ever needed
+    if( count == 0) count = 1;
+
+    uint32_t taken[ TFMP_SCHED_MAX_SENSORS];  // a bit for each minor cycle
+    for( uint8_t s = 0; s < count; s++) taken[ s] = 0;
+
+    bool fits = true;
+    for( uint8_t k = 0; k < 32; k++)
+    {
+      for( uint8_t i = 0; i < sensors; i++)
+      {
+        Entry &e = entry[ i];
+        if( e.shift != k) continue;
+        // Minor cycles this sensor is read in, from the first.  One
+        // slower than the major cycle keeps a slot in one of them.
+        uint8_t step = ( k < 5) ? uint8_t( 1 << k) : 32;
+        uint32_t bits = 0;
+        for( uint8_t j = 0; j < 32; j += step) bits |= 1UL << j;
+
+        bool placed = false;
+        for( uint8_t s = 0; s < count && !placed; s++)
+        {
+          for( uint8_t c = 0; c < step && !placed; c++)
+          {
+            if( taken[ s] & ( bits << c)) continue;
+            taken[ s] |= bits << c;
+            e.offset = c * minor + s * read;
+            placed = true;
+          }
+        }
+        if( !placed)
+        {
+          e.offset = uint32_t( i) * read;
+          fits = false;
+        }
+      }
+    }
+    return fits;
+}
+
+bool TFMPPlanner::apply( TFMPScheduler &sched, uint32_t now)
+{
+    if( sched.count() != 0) return false;
+    uint32_t offsets[ TFMP_SCHED_MAX_SENSORS];
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      if( sched.addPeriod( entry[ i].addr, entry[ i].period) < 0) return false;
+      offsets[ i] = entry[ i].offset;
+    }
+    sched.begin( now, offsets);
+    return true;
+}
@@ -0,0 +1,98 @@
+/* File Name: TFMPPlanner.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bus time budget planning for the TFMPI2C library.
+ *
+ *  Every `getData()` is a 5 byte frame request and a 9 byte frame read,
+ *  each with its address byte, start and stop, or 148 bus clocks in all.
+ *  That is about 1.5ms at 100KHz or 0.4ms at 400KHz, plus some time in
+ *  software.  So a bus can only carry so many reads each second, and
+ *  a sensor cannot give new data faster than its own frame-rate.
+ *
+ *  A `TFMPPlanner` is given every sensor on a bus, the rate each one is
+ *  wanted at, and the bus clock.  `plan()` shares out the bus time:
+ *    - No sensor is given more than its frame-rate.
+ *    - If there is room for every wanted rate, each gets what it wants.
+ *    - If not, the sensors that want least are given all they want and
+ *      the rest share what is left equally.
+ *  Only `load` percent of the bus time is planned, leaving some spare.
+ *
+ *  Reads at unrelated rates would meet again and again as they drift
+ *  past each other.  So each rate is then rounded to a harmonic period,
+ *  the fastest sensor's period times a power of two.  A rate is rounded
+ *  up if the bus and the device frame-rate have room for it, otherwise
+ *  down.  The fastest period is the minor cycle.  It is cut into slots
+ *  one read long, and every sensor is given a fixed slot in one or more
+ *  minor cycles of a major cycle 32 minor cycles long.  No two reads
+ *  ever share a slot, so every read starts on time unless a read runs
+ *  longer than planned.
+ *
+ *  `plan()` returns `true` only if every sensor gets its wanted rate
+ *  and the plan fits the bus.  `feasible( index)` is `false` for each
+ *  sensor that does not get its wanted rate, and `rate( index)` is the
+ *  rate that it has.  `overloaded` is `true` if even one read each
+ *  second for every sensor is more than `load` allows, or if the reads
+ *  do not all fit in slots of their own.  `utilization` is then more
+ *  than `load`, and can be more than 100.
+ *
+ *  `apply()` puts the plan in a `TFMPScheduler`.
+ */
+
+#ifndef TFMPPLANNER_H       // Guard to compile only once
+#define TFMPPLANNER_H
+
+#include "TFMPScheduler.h"
+
+#define TFMP_PLAN_CLOCKS      148   // bus clocks in one getData()
+#define TFMP_PLAN_OVERHEAD    100   // microseconds in software per read
+
+class TFMPPlanner
+{
+  public:
+    // `busClock` in Hz, `overhead` in microseconds for each read, and
+    // `load` the percent of bus time that may be planned.
+    TFMPPlanner( uint32_t busClock = 100000UL,
+                 uint16_t overhead = TFMP_PLAN_OVERHEAD, uint8_t load = 90);
+
+    // Add a sensor wanted at `wanted` reads a second, with a device
+    // frame-rate of `frameRate`.  Returns its index, or -1 if full.
+    int8_t add( uint8_t addr, uint16_t wanted, uint16_t frameRate = 100);
+    bool plan();
+    // Add every sensor to `sched` at its planned rate and begin.
+    // Returns `false` if `sched` was not empty or is too small.
+    bool apply( TFMPScheduler &sched, uint32_t now);
+
+    uint32_t readMicros() const { return read; }     // time of one read
+    uint16_t capacity() const;                       // reads per second
+    uint8_t utilization;     // percent of bus time used by the plan
+    bool overloaded;         // the plan needs more bus time than it has
+
+    uint16_t rate( int8_t index) const { return entry[ index].rate; }
+    bool feasible( int8_t index) const { return entry[ index].rate >= entry[ index].wanted; }
+    uint32_t period( int8_t index) const { return entry[ index].period; }
+    uint32_t offset( int8_t index) const { return entry[ index].offset; }
+
+  private:
+    struct Entry
+    {
+        uint8_t addr;
+        uint16_t wanted;
+        uint16_t frameRate;
+        uint16_t rate;       // planned reads per second
+        uint32_t period;     // microseconds between reads
+        uint8_t shift;       // period is the minor cycle times 2^shift
+        uint32_t offset;     // microseconds to the first read
+    };
+    Entry entry[ TFMP_SCHED_MAX_SENSORS];
+    uint8_t sensors;
+    uint32_t read;           // microseconds for one read
+    uint8_t load;
+
+    void share();
+    void harmonic();
+    bool slots();
+    uint32_t busUse() const;
+};
+
+#endif
@@ -0,0 +1,139 @@
+/* File Name: TFMPProvision.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bulk I2C address provisioning for the TFMPI2C library.
+ *            See `TFMPProvision.h` for a description.
+ */
+
+#include "TFMPProvision.h"
+#include "TFMPLog.h"
+
+TFMPProvision::TFMPProvision( TFMPI2C &tfm)
+  : bootWait( TFMP_BOOT_WAIT), tfm( tfm), enable( NULL), context( NULL)
+{
+  #if defined( ARDUINO)
+    pins = NULL;
+    activeHigh = true;
+  #endif
+}
+
+#if defined( ARDUINO)
+void TFMPProvision::setPins( const uint8_t newPins[], bool newActiveHigh)
+{
+    pins = newPins;
+    activeHigh = newActiveHigh;
+    enable = pinEnable;
+    context = this;
+}
+
+void TFMPProvision::pinEnable( uint8_t index, bool on, void *context)
+{
+    TFMPProvision *p = (TFMPProvision *)context;
+    pinMode( p->pins[ index], OUTPUT);
+    digitalWrite( p->pins[ index], ( on == p->activeHigh) ? HIGH : LOW);
+}
+#endif
+
+void TFMPProvision::setEnable( TFMPEnableFunc function, void *newContext)
+{
+    enable = function;
+    context = newContext;
+}
+
+// True if any device acknowledges `addr`.
+bool TFMPProvision::present( uint8_t addr)
+{
+    uint8_t err = tfm.getBus().write( addr, NULL, 0);
+    TFMP_LOG_BUS( 'W', addr, NULL, 0, err);
+    return err == TFMP_BUS_OK;
+}
+
+// Ask for the firmware version until the device replies or
+// `ms` milliseconds pass.  A sensor that is still starting
+// up does not acknowledge, so keep trying.
+bool TFMPProvision::waitVersion( uint8_t addr, uint16_t ms)
+{
+    TFMPBus &bus = tfm.getBus();
+    uint32_t start = bus.getMicros();
+    for( ;;)
+    {
+      bool sent = tfm.sendRequest( GET_FIRMWARE_VERSION, 0, addr);
+      bus.wait( 5);
+      if( sent && tfm.getReply( GET_FIRMWARE_VERSION, 0, addr)) return true;
+      if( ( bus.getMicros() - start) >= ms * 1000UL) return false;
+    }
+}
+
+uint8_t TFMPProvision::run( uint8_t count, uint8_t firstAddr, TFMPProvResult results[])
+{
+    uint8_t passed = 0;
+    for( uint8_t i = 0; i < count; i++)
+    {
+      results[ i].addr = firstAddr + i;
+      results[ i].result = TFMP_PROV_SKIPPED;
+      results[ i].status = TFMP_READY;
+      memset( results[ i].version, 0, 3);
+    }
+    if( enable == NULL) return 0;
+
+    // - - Step 0 - Every new address must be free to use - -
+    uint16_t lastAddr = uint16_t( firstAddr) + count - 1;
+    if( count > 0 && ( firstAddr < 1 || lastAddr > 127 ||
+        ( firstAddr <= TFMP_DEFAULT_ADDRESS && lastAddr >= TFMP_DEFAULT_ADDRESS)))
+    {
+      for( uint8_t i = 0; i < count; i++) results[ i].result = TFMP_PROV_RANGE;
+      return 0;
+    }
+
+    // - - Step 1 - Everything off, default address must be free - -
+    for( uint8_t i = 0; i < count; i++) enable( i, false, context);
+    tfm.getBus().wait( 10);
+    if( present( TFMP_DEFAULT_ADDRESS))
+    {
+      if( count > 0) results[ 0].result = TFMP_PROV_BUSY;
+      return 0;
+    }
+
+    for( uint8_t i = 0; i < count; i++)
+    {
+      TFMPProvResult &r = results[ i];
+
+      // - - Step 2 - Switch on one sensor and wait for it - -
+      enable( i, true, context);
+      if( !waitVersion( TFMP_DEFAULT_ADDRESS, bootWait))
+      {
+        r.result = TFMP_PROV_ABSENT;
+      }
+      else if( present( r.addr))
+      {
+        r.result = TFMP_PROV_TAKEN;
+      }
+      // - - Step 3 - New address, then save - -
+      else if( !tfm.sendCommand( SET_I2C_ADDRESS, r.addr, TFMP_DEFAULT_ADDRESS))
+      {
+        r.result = TFMP_PROV_ADDRESS;
+      }
+      else if( !tfm.sendCommand( SAVE_SETTINGS, 0, r.addr))
+      {
+        r.result = TFMP_PROV_SAVE;
+      }
+      // - - Step 4 - Check the new address - -
+      else if( !tfm.sendCommand( GET_FIRMWARE_VERSION, 0, r.addr) ||
+               present( TFMP_DEFAULT_ADDRESS))
+      {
+        r.result = TFMP_PROV_VERIFY;
+      }
+      else
+      {
+        r.result = TFMP_PROV_OK;
+        memcpy( r.version, tfm.version, 3);
+        ++passed;
+      }
+      r.status = tfm.status;
+
+      // - - Step 5 - Keep a good sensor on, switch off a bad one - -
+      if( r.result != TFMP_PROV_OK) enable( i, false, context);
+    }
+    return passed;
+}
@@ -0,0 +1,93 @@
+/* File Name: TFMPProvision.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bulk I2C address provisioning for the TFMPI2C library.
+ *
+ *  Every TFMini-Plus comes from the factory at address 0x10, so several
+ *  of them cannot share a bus until each has been given its own address.
+ *  If every sensor's power (or enable) line is switched by its own pin,
+ *  a `TFMPProvision` object can do that for a whole harness in one pass:
+ *    1. Switch every sensor off and make sure that nothing is left
+ *       answering at the default address.
+ *    2. Switch on one sensor and wait for it to answer a request for
+ *       its firmware version at the default address.
+ *    3. Send SET_I2C_ADDRESS for the next address in sequence, then
+ *       SAVE_SETTINGS at the new address.
+ *    4. Check that the sensor answers at its new address and that
+ *       nothing answers at the default address any more.
+ *    5. Leave it switched on and move on to the next sensor.
+ *  A sensor that fails at any step is switched off again, so that it
+ *  cannot get in the way of the next one, and its result code tells
+ *  which step failed.
+ *
+ *  'run( count, firstAddr, results)' provisions `count` sensors to
+ *   addresses `firstAddr`, `firstAddr + 1`, ... and returns the number
+ *   that passed.  `results` must have room for `count` entries.
+ *   The range must not hold the default address, which every sensor
+ *   not yet switched on still answers to, and must end by 127.
+ *   Otherwise no sensor is switched on and every result is RANGE.
+ *
+ *  On an Arduino, `setPins( pins, activeHigh)` names a pin for each
+ *  sensor.  Otherwise, `setEnable( function, context)` names a function
+ *  that will be called to switch sensor `index` on or off.
+ */
+
+#ifndef TFMPPROVISION_H       // Guard to compile only once
+#define TFMPPROVISION_H
+
+#include "TFMPI2C.h"
+
+// Provisioning result codes
+#define TFMP_PROV_OK           0   // address set, saved and checked
+#define TFMP_PROV_BUSY         1   // default address in use before start
+#define TFMP_PROV_ABSENT       2   // no reply at the default address
+#define TFMP_PROV_TAKEN        3   // new address already in use
+#define TFMP_PROV_ADDRESS      4   // SET_I2C_ADDRESS failed
+#define TFMP_PROV_SAVE         5   // SAVE_SETTINGS failed
+#define TFMP_PROV_VERIFY       6   // no reply at the new address
+#define TFMP_PROV_SKIPPED      7   // not tried because of an earlier error
+#define TFMP_PROV_RANGE        8   // address range holds 0x10 or passes 127
+
+// Result for one sensor
+struct TFMPProvResult
+{
+    uint8_t addr;          // address given to the sensor
+    uint8_t result;        // PROV result code
+    uint8_t status;        // TFMPI2C status at the failed step
+    uint8_t version[ 3];   // firmware version
+};
+
+typedef void (*TFMPEnableFunc)( uint8_t index, bool on, void *context);
+
+class TFMPProvision
+{
+  public:
+    TFMPProvision( TFMPI2C &tfm);
+
+  #if defined( ARDUINO)
+    // One enable pin for each sensor.  The array must last
+    // as long as this object.
+    void setPins( const uint8_t pins[], bool activeHigh = true);
+  #endif
+    void setEnable( TFMPEnableFunc function, void *context = NULL);
+
+    uint8_t run( uint8_t count, uint8_t firstAddr, TFMPProvResult results[]);
+
+    uint16_t bootWait;     // ms to wait for each sensor to start
+
+  private:
+    TFMPI2C &tfm;
+    TFMPEnableFunc enable;
+    void *context;
+  #if defined( ARDUINO)
+    const uint8_t *pins;
+    bool activeHigh;
+    static void pinEnable( uint8_t index, bool on, void *context);
+  #endif
+
+    bool present( uint8_t addr);
+    bool waitVersion( uint8_t addr, uint16_t ms);
+};
+
+#endif
@@ -0,0 +1,225 @@
+/* File Name: TFMPReplay.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Record and replay of I2C bus traffic for the TFMPI2C library.
+ *            See `TFMPReplay.h` for a description of the format.
+ */
+
+#include "TFMPReplay.h"
+
+// = = = = = = = = = = =  RECORDING BUS  = = = = = = = = = = = = =
+//
+#if defined( ARDUINO)
+TFMPRecordBus::TFMPRecordBus( TFMPBus &inner, Print &out)
+  : inner( inner), out( out), lastTime( 0) {}
+#else
+TFMPRecordBus::TFMPRecordBus( TFMPBus &inner, FILE *out)
+  : inner( inner), out( out), lastTime( 0) {}
+#endif
+
+void TFMPRecordBus::put( const uint8_t *data, size_t len)
+{
+  #if defined( ARDUINO)
+    out.write( data, len);
+  #else
+    fwrite( data, 1, len, out);
+  #endif
+}
+
+void TFMPRecordBus::begin()
+{
+    lastTime = inner.getMicros();
+    const uint8_t head[ 9] = { 'T', 'F', 'M', 'R', TFMP_REPLAY_VERSION,
+                               uint8_t( lastTime), uint8_t( lastTime >> 8),
+                               uint8_t( lastTime >> 16), uint8_t( lastTime >> 24) };
+    put( head, sizeof( head));
+}
+
+void TFMPRecordBus::entry( uint8_t kind, uint8_t addr, uint8_t result,
+      uint8_t len, uint32_t time, const uint8_t *data, uint8_t count)
+{
+    uint8_t head[ 9];
+    head[ 0] = kind;
+    head[ 1] = addr;
+    head[ 2] = result;
+    head[ 3] = len;
+    uint8_t n = 4;
+    uint32_t v = time - lastTime;  // Time as an unsigned varint
+    while( v >= 0x80)
+    {
+      head[ n++] = uint8_t( v) | 0x80;
+      v >>= 7;
+    }
+    head[ n++] = uint8_t( v);
+    lastTime = time;
+
+    put( head, n);
+    put( data, count);
+}
+
+uint8_t TFMPRecordBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    uint32_t time = inner.getMicros();
+    uint8_t err = inner.write( addr, data, len);
+    entry( 'W', addr, err, len, time, data, len);
+    return err;
+}
+
+uint8_t TFMPRecordBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    uint32_t time = inner.getMicros();
+    uint8_t count = inner.read( addr, data, len);
+    entry( 'R', addr, count, len, time, data, count);
+    return count;
+}
+
+uint32_t TFMPRecordBus::getMicros()
+{
+    return inner.getMicros();
+}
+
+void TFMPRecordBus::wait( uint32_t ms)
+{
+    inner.wait( ms);
+}
+
+void TFMPRecordBus::lock()
+{
+    inner.lock();
+}
+
+void TFMPRecordBus::unlock()
+{
+    inner.unlock();
+}
+//
+// - - - - - - - - - -  End of Recording Bus  - - - - - - - - - - -
+
+
+#if !defined( ARDUINO)
+// = = = = = = = = = = =  REPLAY BUS  = = = = = = = = = = = = = = =
+//
+TFMPReplayBus::TFMPReplayBus( FILE *in)
+  : entries( 0), mismatches( 0), in( in), ended( false), time( 0),
+    haveAhead( false) {}
+
+bool TFMPReplayBus::begin()
+{
+    uint8_t head[ 9];
+    if( fread( head, 1, sizeof( head), in) != sizeof( head) ||
+        memcmp( head, "TFMR", 4) != 0 ||
+        head[ 4] != TFMP_REPLAY_VERSION)
+    {
+      ended = true;
+      return false;
+    }
+    // Entry times count on from the time the recording began.
+    time = head[ 5] | ( uint32_t( head[ 6]) << 8) |
+           ( uint32_t( head[ 7]) << 16) | ( uint32_t( head[ 8]) << 24);
+    return true;
+}
+
+// Read the next entry from the file.
+bool TFMPReplayBus::load( Entry &e)
+{
+    uint8_t head[ 4];
+    if( ended || fread( head, 1, 4, in) != 4)
+    {
+      ended = true;
+      return false;
+    }
+    e.kind   = head[ 0];
+    e.addr   = head[ 1];
+    e.result = head[ 2];
+    e.len    = head[ 3];
+
+    uint32_t v = 0;                // Time as an unsigned varint
+    for( uint8_t i = 0; i < 5; i++)
+    {
+      int c = fgetc( in);
+      if( c == EOF)
+      {
+        ended = true;
+        return false;
+      }
+      v |= uint32_t( c & 0x7F) << ( 7 * i);
+      if( ( c & 0x80) == 0) break;
+    }
+    time += v;
+    e.time = time;
+
+    uint8_t count = ( e.kind == 'W') ? e.len : e.result;
+    if( count > TFMP_REPLAY_DATA_MAX ||
+        fread( e.data, 1, count, in) != count)
+    {
+      ended = true;
+      return false;
+    }
+    return true;
+}
+
+// Take the next entry of the recording, which
+// `getMicros()` may already have loaded.
+bool TFMPReplayBus::next( Entry &e)
+{
+    if( haveAhead)
+    {
+      e = ahead;
+      haveAhead = false;
+    }
+    else if( !load( e)) return false;
+    ++entries;
+    return true;
+}
+
+uint8_t TFMPReplayBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    Entry e;
+    if( !next( e)) return TFMP_BUS_OTHER;
+    if( e.kind != 'W' || e.addr != addr || e.len != len ||
+        memcmp( e.data, data, len) != 0)
+    {
+      ++mismatches;
+      if( e.kind != 'W') return TFMP_BUS_OTHER;
+    }
+    return e.result;
+}
+
+uint8_t TFMPReplayBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    Entry e;
+    if( !next( e)) return 0;
+    if( e.kind != 'R' || e.addr != addr || e.len != len)
+    {
+      ++mismatches;
+      if( e.kind != 'R') return 0;
+    }
+    uint8_t count = ( e.result < len) ? e.result : len;
+    memcpy( data, e.data, count);
+    return count;
+}
+
+// The library reads the time just before a transfer, i.e. to stamp
+// a sample, so give it the recorded time of the transfer to come.
+// Past the end, keep the time moving so that timeouts still expire.
+uint32_t TFMPReplayBus::getMicros()
+{
+    if( !haveAhead) haveAhead = load( ahead);
+    if( haveAhead) return ahead.time;
+    time += TFMP_REPLAY_TICK;
+    return time;
+}
+
+void TFMPReplayBus::wait( uint32_t ms)
+{
+    if( done()) time += ms * 1000UL;
+}
+
+bool TFMPReplayBus::done()
+{
+    return ended && !haveAhead;
+}
+//
+// - - - - - - - - - - -  End of Replay Bus  - - - - - - - - - - - -
+#endif
@@ -0,0 +1,122 @@
+/* File Name: TFMPReplay.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Record and replay of I2C bus traffic for the TFMPI2C library.
+ *
+ *  'TFMPRecordBus' wraps around another bus, i.e. the default Wire bus,
+ *  and passes every transfer through unchanged.  It also writes each
+ *  transfer (address, bytes written, bytes read and a timestamp) to a
+ *  `Print` object such as `Serial` or an SD card file on the Arduino,
+ *  or to a `FILE` on a host computer.
+ *
+ *  'TFMPReplayBus' runs on a host computer.  It reads a recording back
+ *  in place of a real bus.  Every write by the library is checked
+ *  against the recording and every read is answered from it.  The
+ *  command reply delay is skipped and `getMicros()` returns the
+ *  recorded time of the transfer that comes next, which is the time
+ *  the live run read to stamp its sample.  So a session replays as
+ *  fast as the CPU allows and filters see exactly the same data and
+ *  timing every time.
+ *
+ *  Once the recording runs out, every transfer fails and the time goes
+ *  on by the length of each `wait()` plus TFMP_REPLAY_TICK for each
+ *  `getMicros()`, so that any loop with a time limit comes to an end.
+ *
+ *  Recording format:
+ *    Header  'T' 'F' 'M' 'R', format version (2),
+ *            start time: 4 bytes, microseconds, low byte first
+ *    Entry   Byte0  kind: 'W' for a write, 'R' for a read
+ *            Byte1  I2C address
+ *            Byte2  result: write error code or count of bytes read
+ *            Byte3  length: bytes written or bytes requested
+ *            Time   unsigned varint: microseconds since the last entry
+ *            Data   bytes written ('W': length) or read ('R': result)
+ */
+
+#ifndef TFMPREPLAY_H       // Guard to compile only once
+#define TFMPREPLAY_H
+
+#include "TFMPBus.h"
+
+#if !defined( ARDUINO)
+  #include <stdio.h>
+#endif
+
+#define TFMP_REPLAY_VERSION    2
+#define TFMP_REPLAY_TICK       1   // microseconds per getMicros() once ended
+#define TFMP_REPLAY_DATA_MAX  32   // longest transfer that can be replayed
+
+class TFMPRecordBus : public TFMPBus
+{
+  public:
+  #if defined( ARDUINO)
+    TFMPRecordBus( TFMPBus &inner, Print &out);
+  #else
+    TFMPRecordBus( TFMPBus &inner, FILE *out);
+  #endif
+
+    // Write the recording header.  Call once before the first transfer.
+    void begin();
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+    uint32_t getMicros();
+    void wait( uint32_t ms);
+    void lock();
+    void unlock();
+
+  private:
+    TFMPBus &inner;
+  #if defined( ARDUINO)
+    Print &out;
+  #else
+    FILE *out;
+  #endif
+    uint32_t lastTime;
+
+    void entry( uint8_t kind, uint8_t addr, uint8_t result, uint8_t len,
+                uint32_t time, const uint8_t *data, uint8_t count);
+    void put( const uint8_t *data, size_t len);
+};
+
+#if !defined( ARDUINO)
+class TFMPReplayBus : public TFMPBus
+{
+  public:
+    TFMPReplayBus( FILE *in);
+
+    // Read and check the recording header.
+    bool begin();
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+    uint32_t getMicros();          // recorded time of the next transfer
+    void wait( uint32_t ms);       // returns at once
+
+    bool done();                   // end of recording reached
+    uint32_t entries;              // transfers replayed
+    uint32_t mismatches;           // writes that differ from the recording
+
+  private:
+    FILE *in;
+    bool ended;
+    uint32_t time;                 // recorded time of the last entry loaded
+
+    struct Entry
+    {
+      uint8_t kind;
+      uint8_t addr;
+      uint8_t result;
+      uint8_t len;
+      uint32_t time;
+      uint8_t data[ TFMP_REPLAY_DATA_MAX];
+    };
+    Entry ahead;                   // next entry, loaded early by `getMicros()`
+    bool haveAhead;
+    bool load( Entry &e);
+    bool next( Entry &e);
+};
+#endif
+
+#endif
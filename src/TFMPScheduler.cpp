@@ -0,0 +1,189 @@
+/* File Name: TFMPScheduler.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Deadline poll scheduling for the TFMPI2C library.
+ *            See `TFMPScheduler.h` for a description.
+ */
+
+#include "TFMPScheduler.h"
+
+TFMPScheduler::TFMPScheduler()
+  : sensors( 0), sampleAll( NULL), errorAll( NULL), changeAll( NULL),
+    sampleContext( NULL), errorContext( NULL), changeContext( NULL) {}
+
+int8_t TFMPScheduler::add( uint8_t addr, uint16_t rate)
+{
+    if( rate == 0) return -1;
+    return addPeriod( addr, 1000000UL / rate);
+}
+
+int8_t TFMPScheduler::addPeriod( uint8_t addr, uint32_t period)
+{
+    if( sensors >= TFMP_SCHED_MAX_SENSORS || period == 0) return -1;
+    Entry &e = entry[ sensors];
+    e.addr = addr;
+    e.period = period;
+    e.next = 0;
+    e.misses = 0;
+    e.status = TFMP_READY;
+  #if !defined( TFMP_COMPACT)
+    e.sample = NULL;
+    e.error = NULL;
+    e.change = NULL;
+    e.sampleContext = NULL;
+    e.errorContext = NULL;
+    e.changeContext = NULL;
+  #endif
+    return sensors++;
+}
+
+void TFMPScheduler::begin( uint32_t now)
+{
+    // Stagger the first reads across each sensor's own period.
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      entry[ i].next = now + ( entry[ i].period / sensors) * i;
+      entry[ i].misses = 0;
+    }
+}
+
+void TFMPScheduler::begin( uint32_t now, const uint32_t offset[])
+{
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      entry[ i].next = now + offset[ i];
+      entry[ i].misses = 0;
+    }
+}
+
+int8_t TFMPScheduler::due( uint32_t now, uint32_t &waitMicros)
+{
+    int8_t first = -1;
+    int32_t earliest = 0;     // deadline relative to now
+    for( uint8_t i = 0; i < sensors; i++)
+    {
+      int32_t d = int32_t( entry[ i].next - now);
+      if( first < 0 || d < earliest)
+      {
+        first = i;
+        earliest = d;
+      }
+    }
+    if( first < 0)
+    {
+      waitMicros = 1000000UL;
+      return -1;
+    }
+    if( earliest > 0)
+    {
+      waitMicros = uint32_t( earliest);
+      return -1;
+    }
+    waitMicros = 0;
+    return first;
+}
+
+void TFMPScheduler::done( int8_t index, uint32_t now)
+{
+    Entry &e = entry[ index];
+    e.next += e.period;
+    // More than a whole period behind, so start again from now.
+    if( int32_t( now - e.next) >= int32_t( e.period))
+    {
+      e.next = now + e.period;
+      ++e.misses;
+    }
+}
+
+// = = = = = = = = = = = = =  CALLBACKS  = = = = = = = = = = = = = =
+//
+void TFMPScheduler::onSample( TFMPSampleFunc func, void *context)
+{
+    sampleAll = func;
+    sampleContext = context;
+}
+
+void TFMPScheduler::onError( TFMPSampleFunc func, void *context)
+{
+    errorAll = func;
+    errorContext = context;
+}
+
+void TFMPScheduler::onStatusChange( TFMPSampleFunc func, void *context)
+{
+    changeAll = func;
+    changeContext = context;
+}
+
+#if defined( TFMP_COMPACT)
+// No callbacks of their own for each sensor
+bool TFMPScheduler::onSample( int8_t, TFMPSampleFunc, void *) { return false; }
+bool TFMPScheduler::onError( int8_t, TFMPSampleFunc, void *) { return false; }
+bool TFMPScheduler::onStatusChange( int8_t, TFMPSampleFunc, void *) { return false; }
+#else
+bool TFMPScheduler::onSample( int8_t index, TFMPSampleFunc func, void *context)
+{
+    if( index < 0 || index >= sensors) return false;
+    entry[ index].sample = func;
+    entry[ index].sampleContext = context;
+    return true;
+}
+
+bool TFMPScheduler::onError( int8_t index, TFMPSampleFunc func, void *context)
+{
+    if( index < 0 || index >= sensors) return false;
+    entry[ index].error = func;
+    entry[ index].errorContext = context;
+    return true;
+}
+
+bool TFMPScheduler::onStatusChange( int8_t index, TFMPSampleFunc func, void *context)
+{
+    if( index < 0 || index >= sensors) return false;
+    entry[ index].change = func;
+    entry[ index].changeContext = context;
+    return true;
+}
+#endif
+
+// Call the sensor's own callback if it has one, otherwise the one for all.
+void TFMPScheduler::dispatch( TFMPSampleFunc own, void *ownContext,
+                              TFMPSampleFunc all, void *allContext,
+                              uint8_t index, const TFMPSample &s)
+{
+    if( own) own( index, s, ownContext);
+      else if( all) all( index, s, allContext);
+}
+
+bool TFMPScheduler::poll( TFMPI2C &tfm)
+{
+    TFMPBus &bus = tfm.getBus();
+    uint32_t waitMicros;
+    int8_t i = due( bus.getMicros(), waitMicros);
+    if( i < 0) return false;
+
+    Entry &e = entry[ i];
+    TFMPSample s;
+    bool passed = tfm.getData( s, e.addr);
+    done( i, bus.getMicros());
+
+  #if defined( TFMP_COMPACT)
+    TFMPSampleFunc sample = NULL, error = NULL, change = NULL;
+    void *sampleOwn = NULL, *errorOwn = NULL, *changeOwn = NULL;
+  #else
+    TFMPSampleFunc sample = e.sample, error = e.error, change = e.change;
+    void *sampleOwn = e.sampleContext, *errorOwn = e.errorContext,
+         *changeOwn = e.changeContext;
+  #endif
+    if( s.status != e.status)
+    {
+      e.status = s.status;
+      dispatch( change, changeOwn, changeAll, changeContext, i, s);
+    }
+    if( passed) dispatch( sample, sampleOwn, sampleAll, sampleContext, i, s);
+      else dispatch( error, errorOwn, errorAll, errorContext, i, s);
+    return true;
+}
+//
+// - - - - - - - - - - - - -  End of Callbacks  - - - - - - - - - - - -
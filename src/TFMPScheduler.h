@@ -0,0 +1,123 @@
+/* File Name: TFMPScheduler.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Deadline poll scheduling for the TFMPI2C library.
+ *
+ *  A `TFMPScheduler` keeps a list of sensors on one bus, each with its
+ *  own read rate, and decides which one to read next.  Every sensor has
+ *  a deadline, and the one with the earliest deadline that has passed
+ *  is read first.  Sensors start at staggered times so that their reads
+ *  are spread across the period rather than bunched together.
+ *
+ *  'add( addr, rate)' adds a sensor to be read `rate` times a second
+ *   and returns its index, or -1 if the list is full.
+ *  'addPeriod( addr, period)' does the same with the time between reads
+ *   in microseconds, for a period that is not a whole number of rates.
+ *  'begin( now)' sets the first deadlines.
+ *  'due( now, waitMicros)' returns the index of the sensor to read now,
+ *   or -1 if none is due, in which case `waitMicros` is the time until
+ *   the next one is.
+ *  'done( index, now)' must be called after each read.  It sets the next
+ *   deadline one period after the last.  A sensor that has fallen more
+ *   than a whole period behind starts again from now and counts a miss.
+ *
+ *  On an Arduino, call `due()` from the main loop:
+ *      uint32_t wait;
+ *      int8_t i = sched.due( micros(), wait);
+ *      if( i >= 0)
+ *      {
+ *        tfmP.getData( sample, sched.addr( i));
+ *        sched.done( i, micros());
+ *      }
+ *
+ *  Or let the scheduler make the read and call back with the result:
+ *  'poll( tfm)' reads the sensor that is due, if any, and returns
+ *   `true` if it made a read.  Then it calls:
+ *    - `onStatusChange` if the status differs from that sensor's last,
+ *    - `onSample` if the read passed, or `onError` if it failed.
+ *  Each callback can be set for one sensor, by its index, or for all
+ *  sensors.  A sensor's own callback is used in place of the one for
+ *  all.  A callback is a plain function that is given the sensor index,
+ *  the sample and the `context` pointer that was set with it, and the
+ *  sample is passed by reference, so nothing is copied or allocated.
+ *
+ *  With TFMP_COMPACT defined (see `TFMPI2C.h`) each sensor entry drops
+ *  its own callbacks and keeps a 16-bit miss count, which saves 14 bytes
+ *  a sensor on an AVR.  Only the callbacks for all sensors can be set,
+ *  and the ones for a single sensor return `false`.  `ramPerSensor()`
+ *  gives the size of one entry.
+ */
+
+#ifndef TFMPSCHEDULER_H       // Guard to compile only once
+#define TFMPSCHEDULER_H
+
+#include "TFMPI2C.h"
+
+#ifndef TFMP_SCHED_MAX_SENSORS
+#define TFMP_SCHED_MAX_SENSORS   8
+#endif
+
+// Callback for a sample from sensor `index`
+typedef void (*TFMPSampleFunc)( uint8_t index, const TFMPSample &s, void *context);
+
+class TFMPScheduler
+{
+  public:
+    TFMPScheduler();
+
+    int8_t add( uint8_t addr, uint16_t rate);
+    int8_t addPeriod( uint8_t addr, uint32_t period);
+    void begin( uint32_t now);
+    // Begin with the first read of each sensor `offset[ index]`
+    // microseconds from now, as planned by a `TFMPPlanner`.
+    void begin( uint32_t now, const uint32_t offset[]);
+    int8_t due( uint32_t now, uint32_t &waitMicros);
+    void done( int8_t index, uint32_t now);
+
+    bool poll( TFMPI2C &tfm);
+
+    // Callbacks for every sensor
+    void onSample( TFMPSampleFunc func, void *context = NULL);
+    void onError( TFMPSampleFunc func, void *context = NULL);
+    void onStatusChange( TFMPSampleFunc func, void *context = NULL);
+    // Callbacks for one sensor.  Returns `false` if there is
+    // no such sensor.
+    bool onSample( int8_t index, TFMPSampleFunc func, void *context = NULL);
+    bool onError( int8_t index, TFMPSampleFunc func, void *context = NULL);
+    bool onStatusChange( int8_t index, TFMPSampleFunc func, void *context = NULL);
+
+    uint8_t count() const { return sensors; }
+    uint8_t addr( int8_t index) const { return entry[ index].addr; }
+    uint32_t misses( int8_t index) const { return entry[ index].misses; }
+    static size_t ramPerSensor() { return sizeof( Entry); }
+
+  private:
+    struct Entry
+    {
+        uint8_t addr;
+        uint32_t period;     // microseconds between reads
+        uint32_t next;       // deadline of the next read
+      #if defined( TFMP_COMPACT)
+        uint16_t misses;     // deadlines missed by a whole period
+        uint8_t status;      // status of the last read
+      #else
+        uint32_t misses;     // deadlines missed by a whole period
+        uint8_t status;      // status of the last read
+        TFMPSampleFunc sample, error, change;
+        void *sampleContext, *errorContext, *changeContext;
+      #endif
+    };
+    Entry entry[ TFMP_SCHED_MAX_SENSORS];
+    uint8_t sensors;
+
+    // Callbacks for every sensor
+    TFMPSampleFunc sampleAll, errorAll, changeAll;
+    void *sampleContext, *errorContext, *changeContext;
+
+    void dispatch( TFMPSampleFunc own, void *ownContext,
+                   TFMPSampleFunc all, void *allContext,
+                   uint8_t index, const TFMPSample &s);
+};
+
+#endif
@@ -0,0 +1,168 @@
+/* File Name: TFMPStatsBus.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bus traffic accounting for the TFMPI2C library.
+ *            See `TFMPStatsBus.h` for a description.
+ */
+
+#include "TFMPStatsBus.h"
+
+TFMPStatsBus::TFMPStatsBus( TFMPBus &inner, uint32_t bucketMicros)
+  : inner( inner), bucketMicros( bucketMicros ? bucketMicros : 1)
+{
+    clear();
+}
+
+void TFMPStatsBus::clear()
+{
+    memset( &total, 0, sizeof( total));
+    devices = 0;
+    memset( busy, 0, sizeof( busy));
+    bucket = 0;
+    bucketStart = 0;
+    started = false;
+}
+
+TFMPBusCounts *TFMPStatsBus::find( uint8_t addr)
+{
+    for( uint8_t i = 0; i < devices; i++)
+    {
+      if( addrList[ i] == addr) return &counts[ i];
+    }
+    if( devices >= TFMP_STATS_MAX_ADDR) return NULL;
+    addrList[ devices] = addr;
+    memset( &counts[ devices], 0, sizeof( TFMPBusCounts));
+    return &counts[ devices++];
+}
+
+const TFMPBusCounts *TFMPStatsBus::device( uint8_t addr) const
+{
+    for( uint8_t i = 0; i < devices; i++)
+    {
+      if( addrList[ i] == addr) return &counts[ i];
+    }
+    return NULL;
+}
+
+// Move on to the bucket that holds `now`, clearing any passed over.
+void TFMPStatsBus::advance( uint32_t now)
+{
+    if( !started)
+    {
+      started = true;
+      bucketStart = now;
+      return;
+    }
+    uint32_t gone = now - bucketStart;
+    // Divide rather than multiply, which could overflow for long
+    // buckets, and only once a bucket has passed.
+    if( gone >= bucketMicros && gone / bucketMicros > TFMP_STATS_BUCKETS)
+    {
+      // Idle for longer than all the buckets.
+      memset( busy, 0, sizeof( busy));
+      bucketStart = now;
+      return;
+    }
+    while( gone >= bucketMicros)
+    {
+      bucket = ( bucket + 1) % ( TFMP_STATS_BUCKETS + 1);
+      busy[ bucket] = 0;
+      bucketStart += bucketMicros;
+      gone -= bucketMicros;
+    }
+}
+
+// Add busy time, split across buckets if it crosses a boundary.
+void TFMPStatsBus::addBusy( uint32_t start, uint32_t end)
+{
+    advance( start);
+    for( ;;)
+    {
+      uint32_t bucketEnd = bucketStart + bucketMicros;
+      if( int32_t( end - bucketEnd) <= 0)
+      {
+        busy[ bucket] += end - start;
+        return;
+      }
+      busy[ bucket] += bucketEnd - start;
+      start = bucketEnd;
+      advance( start);
+    }
+}
+
+uint8_t TFMPStatsBus::utilization( uint8_t buckets)
+{
+    if( buckets == 0 || !started) return 0;
+    if( buckets > TFMP_STATS_BUCKETS) buckets = TFMP_STATS_BUCKETS;
+    advance( inner.getMicros());
+    // Whole buckets only, so skip the present one.
+    uint32_t sum = 0;
+    for( uint8_t i = 1; i <= buckets; i++)
+    {
+      sum += busy[ ( bucket + TFMP_STATS_BUCKETS + 1 - i) % ( TFMP_STATS_BUCKETS + 1)];
+    }
+    return uint8_t( ( uint64_t( sum) * 100 + ( bucketMicros * buckets) / 2) /
+                    ( uint64_t( bucketMicros) * buckets));
+}
+
+uint8_t TFMPStatsBus::write( uint8_t addr, const uint8_t *data, uint8_t len)
+{
+    uint32_t start = inner.getMicros();
+    uint8_t result = inner.write( addr, data, len);
+    uint32_t end = inner.getMicros();
+    addBusy( start, end);
+
+    TFMPBusCounts *d = find( addr);
+    TFMPBusCounts *c[ 2] = { &total, d };
+    for( uint8_t i = 0; i < 2 && c[ i]; i++)
+    {
+      ++c[ i]->writes;
+      c[ i]->busyMicros += end - start;
+      if( result == TFMP_BUS_OK) c[ i]->bytesOut += len;
+        else if( result == TFMP_BUS_NACK_ADDR || result == TFMP_BUS_NACK_DATA) ++c[ i]->nacks;
+        else ++c[ i]->errors;
+    }
+    return result;
+}
+
+uint8_t TFMPStatsBus::read( uint8_t addr, uint8_t *data, uint8_t len)
+{
+    uint32_t start = inner.getMicros();
+    uint8_t count = inner.read( addr, data, len);
+    uint32_t end = inner.getMicros();
+    addBusy( start, end);
+
+    TFMPBusCounts *d = find( addr);
+    TFMPBusCounts *c[ 2] = { &total, d };
+    for( uint8_t i = 0; i < 2 && c[ i]; i++)
+    {
+      ++c[ i]->reads;
+      c[ i]->busyMicros += end - start;
+      c[ i]->bytesIn += count;
+      // Nothing at all usually means no device answered.
+      if( count == 0 && len > 0) ++c[ i]->nacks;
+        else if( count < len) ++c[ i]->errors;
+    }
+    return count;
+}
+
+uint32_t TFMPStatsBus::getMicros()
+{
+    return inner.getMicros();
+}
+
+void TFMPStatsBus::wait( uint32_t ms)
+{
+    inner.wait( ms);
+}
+
+void TFMPStatsBus::lock()
+{
+    inner.lock();
+}
+
+void TFMPStatsBus::unlock()
+{
+    inner.unlock();
+}
@@ -0,0 +1,93 @@
+/* File Name: TFMPStatsBus.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Bus traffic accounting for the TFMPI2C library.
+ *
+ *  'TFMPStatsBus' wraps around another bus, i.e. the default Wire bus,
+ *  and passes every transfer through unchanged while it counts:
+ *    - writes and reads,
+ *    - bytes written and bytes read,
+ *    - NACKs, and other write errors and short reads,
+ *    - time spent inside the bus calls, in microseconds.
+ *  The counts are kept for the whole bus, `total`, and for each of up
+ *  to TFMP_STATS_MAX_ADDR device addresses, `device( addr)`.
+ *
+ *  Busy time is also kept in TFMP_STATS_BUCKETS time buckets, each
+ *  `bucketMicros` long (default 100ms).  'utilization( buckets)' is the
+ *  percent of the time that the bus was busy over that many of the
+ *  latest whole buckets, so with the defaults `utilization( 1)` covers
+ *  the last 100ms and `utilization( 10)` the last second.
+ *
+ *  The counts are not locked.  If threads share the bus, put the
+ *  `TFMPStatsBus` inside a `TFMPLockedBus`.
+ *
+ *  A bus that is busy more than about 70% of the time leaves little
+ *  room for retries or another sensor.  Move to a 400KHz clock or
+ *  split the sensors across a second bus.
+ */
+
+#ifndef TFMPSTATSBUS_H       // Guard to compile only once
+#define TFMPSTATSBUS_H
+
+#include "TFMPBus.h"
+
+#ifndef TFMP_STATS_MAX_ADDR
+#define TFMP_STATS_MAX_ADDR    8   // devices counted one by one
+#endif
+#ifndef TFMP_STATS_BUCKETS
+#define TFMP_STATS_BUCKETS    10   // time buckets for utilization
+#endif
+
+// Traffic counts for a bus or one device
+struct TFMPBusCounts
+{
+    uint32_t writes;         // write transfers
+    uint32_t reads;          // read transfers
+    uint32_t bytesOut;       // bytes written
+    uint32_t bytesIn;        // bytes read
+    uint32_t nacks;          // address or data not acknowledged
+    uint32_t errors;         // other write errors and short reads
+    uint32_t busyMicros;     // time spent in bus calls
+};
+
+class TFMPStatsBus : public TFMPBus
+{
+  public:
+    TFMPStatsBus( TFMPBus &inner, uint32_t bucketMicros = 100000UL);
+
+    uint8_t write( uint8_t addr, const uint8_t *data, uint8_t len);
+    uint8_t read( uint8_t addr, uint8_t *data, uint8_t len);
+    uint32_t getMicros();
+    void wait( uint32_t ms);
+    void lock();
+    void unlock();
+
+    TFMPBusCounts total;
+    // Counts for one device, or NULL if it has not been
+    // seen or there was no room to count it.
+    const TFMPBusCounts *device( uint8_t addr) const;
+    // Percent of time busy over the latest whole buckets.
+    uint8_t utilization( uint8_t buckets = TFMP_STATS_BUCKETS);
+    void clear();
+
+  private:
+    TFMPBus &inner;
+    uint32_t bucketMicros;
+
+    uint8_t devices;
+    uint8_t addrList[ TFMP_STATS_MAX_ADDR];
+    TFMPBusCounts counts[ TFMP_STATS_MAX_ADDR];
+
+    // Busy time in each bucket, plus the present one
+    uint32_t busy[ TFMP_STATS_BUCKETS + 1];
+    uint8_t bucket;                       // present bucket
+    uint32_t bucketStart;                 // start time of present bucket
+    bool started;
+
+    TFMPBusCounts *find( uint8_t addr);
+    void advance( uint32_t now);
+    void addBusy( uint32_t start, uint32_t end);
+};
+
+#endif
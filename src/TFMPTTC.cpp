@@ -0,0 +1,149 @@
+/* File Name: TFMPTTC.cpp
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Time-to-contact estimator for the TFMPI2C library.
+ *            See `TFMPTTC.h` for a description.
+ *
+ *  Alpha-beta filter, for each new sample:
+ *    predicted = pos + vel * dt
+ *    error     = measured - predicted
+ *    pos       = predicted + alpha * error
+ *    vel       = vel + beta * error / dt
+ *
+ *  The steady state rate error of this filter is about
+ *    sigma * sqrt( 2 * beta^2 / ( alpha * ( 4 - 2 * alpha - beta))) / T
+ *  where sigma is the measurement noise and T is the sample period.
+ *  (Kalata, 'The Tracking Index', IEEE Trans. AES-20, 1984)
+ *  The square root term is worked out once in `begin()`.
+ */
+
+#include "TFMPTTC.h"
+#include <math.h>
+
+// Integer square root, bit by bit.
+static uint32_t isqrt( uint32_t v)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while( bit > v) bit >>= 2;
+    while( bit != 0)
+    {
+      if( v >= root + bit)
+      {
+        v -= root + bit;
+        root = ( root >> 1) + bit;
+      }
+      else root >>= 1;
+      bit >>= 2;
+    }
+    return root;
+}
+
+// Time in ms to cover `pos` (x256) at `speed` (x256 per second).
+static uint32_t timeTo( int32_t pos, int32_t speed)
+{
+    if( speed <= 0) return TFMP_TTC_NONE;
+    if( pos <= 0) return 0;
+    return uint32_t( ( uint64_t( pos) * 1000UL) / uint32_t( speed));
+}
+
+TFMPTTC::TFMPTTC() : warnMs( 0), callback( NULL), context( NULL)
+{
+    begin();
+}
+
+void TFMPTTC::begin( float a, float b)
+{
+    if( a <= 0.0 || a >= 1.0) a = 0.1;
+    if( b <= 0.0 || b >= 1.0) b = 0.005;
+    alpha = uint16_t( a * 65536 + 0.5);
+    beta  = uint16_t( b * 65536 + 0.5);
+    gainV = uint32_t( sqrt( 2.0 * b * b / ( a * ( 4.0 - 2.0 * a - b))) * 65536 + 0.5);
+    reset();
+}
+
+void TFMPTTC::reset()
+{
+    started = false;
+    frames = 0;
+    lastTime = 0;
+    period = 0;
+    pos = 0;
+    vel = 0;
+    var = 0;
+    dist = 0;
+    rate = 0;
+    ttc = TFMP_TTC_NONE;
+    ttcMin = TFMP_TTC_NONE;
+    ttcMax = TFMP_TTC_NONE;
+    warning = false;
+}
+
+void TFMPTTC::onWarning( uint32_t ms, TFMPTTCCallback newCallback, void *newContext)
+{
+    warnMs = ms;
+    callback = newCallback;
+    context = newContext;
+}
+
+void TFMPTTC::update( const TFMPSample &s)
+{
+    if( s.status != TFMP_READY) return;
+    int32_t meas = int32_t( s.dist) * 256;
+    uint32_t dt = s.time - lastTime;
+
+    // - - Start or restart the filter - -
+    if( !started || dt > TFMP_TTC_GAP)
+    {
+      bool wasWarning = warning;
+      reset();
+      started = true;
+      lastTime = s.time;
+      pos = meas;
+      dist = pos;
+      // The restart clears the warning, so say so.
+      if( wasWarning && callback != NULL) callback( *this, s, context);
+      return;
+    }
+    if( dt == 0) return;
+    lastTime = s.time;
+    period = ( period == 0) ? dt : period + ( int32_t( dt - period) >> 3);
+
+    // - - Alpha-beta filter - -
+    int32_t pred = pos + int32_t( int64_t( vel) * int32_t( dt) / 1000000L);
+    int32_t err = meas - pred;
+    pos = pred + int32_t( ( int64_t( alpha) * err) >> 16);
+    // beta * err / dt, where 1000000 / 65536 = 15625 / 1024
+    vel += int32_t( int64_t( beta) * err * 15625L / ( 1024L * int32_t( dt)));
+
+    // - - Running variance of the prediction error - -
+    int32_t e = err >> 4;            // in 1/16 units
+    if( e > 2047) e = 2047;
+    if( e < -2047) e = -2047;
+    var += ( int32_t( e * e) - int32_t( var)) >> 4;
+
+    if( frames < TFMP_TTC_WARMUP) ++frames;
+    dist = pos;
+    rate = -vel / 256;
+    if( frames < TFMP_TTC_WARMUP) return;
+
+    // - - Time to contact and its two sigma bounds - -
+    // Rate error, x256 per second = sigma(1/16) * 16 * gainV / 65536 / T
+    uint32_t sigmaV = uint32_t( uint64_t( isqrt( var)) * gainV * 1000000UL
+                                / ( 4096UL * period));
+    int32_t closing = -vel;
+    ttc    = timeTo( pos, closing);
+    ttcMin = timeTo( pos, closing + int32_t( 2 * sigmaV));
+    ttcMax = timeTo( pos, closing - int32_t( 2 * sigmaV));
+
+    // - - Warning callback, once on each crossing - -
+    // It must rise 25% above the threshold to clear.
+    bool below = warning ? ( ttc < warnMs + ( warnMs >> 2)) : ( ttc < warnMs);
+    if( warnMs == 0) below = false;
+    if( below != warning)
+    {
+      warning = below;
+      if( callback != NULL) callback( *this, s, context);
+    }
+}
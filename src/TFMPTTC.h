@@ -0,0 +1,88 @@
+/* File Name: TFMPTTC.h
+ * Developer: Bud Ryerson
+ * Date:      16 OCT 2026
+ * Version:   1.8.0
+ * Described: Time-to-contact estimator for the TFMPI2C library.
+ *
+ *  Collision avoidance needs to know how soon a target will be reached,
+ *  not just how far away it is.  A `TFMPTTC` object, one for each sensor,
+ *  runs an alpha-beta tracking filter on the timestamped samples from
+ *  `getData( sample, addr)` to estimate distance and approach rate.
+ *  Time to contact is the filtered distance divided by the closing rate.
+ *
+ *  The filter also keeps a running variance of its prediction error,
+ *  from which it derives a rough 95% (two sigma) band on the closing
+ *  rate, and so an early and a late bound on time to contact.
+ *
+ *  `update()` uses no floating point, so it needs no floating point
+ *  unit.  Only `begin()` uses floating point, once.  A few steps do
+ *  need 64-bit multiplies and divides, though.  On a Cortex-M0 or an
+ *  AVR these are library calls, and they take most of the time of an
+ *  update.  Time one update on the target before running it on every
+ *  frame at a high frame-rate.
+ *
+ *  'update( sample)' feeds one sample to the filter.  Samples with an
+ *  error status are ignored.  If a warning callback is set, it is called
+ *  from inside `update()` on the frame that time to contact first drops
+ *  below the warning threshold.  It is called again when the warning
+ *  clears: after time to contact has risen 25% above the threshold, or
+ *  when the filter restarts after a gap in the samples.  Check `warning`
+ *  to tell which.
+ */
+
+#ifndef TFMPTTC_H       // Guard to compile only once
+#define TFMPTTC_H
+
+#include "TFMPI2C.h"
+
+#define TFMP_TTC_NONE     0xFFFFFFFFUL   // not approaching
+#define TFMP_TTC_GAP         500000UL    // restart after a 0.5 second gap
+#define TFMP_TTC_WARMUP          8       // frames before an estimate is given
+
+class TFMPTTC;
+typedef void (*TFMPTTCCallback)( const TFMPTTC &ttc, const TFMPSample &s, void *context);
+
+class TFMPTTC
+{
+  public:
+    TFMPTTC();
+
+    // Set the filter gains.  `alpha` and `beta` are between 0.0 and 1.0
+    // and are stored as fractions of 65536.  Smaller values smooth more
+    // but react more slowly.  The defaults suit 100 to 1000 frames per
+    // second.  At lower frame rates, larger values may be better.
+    void begin( float alpha = 0.1, float beta = 0.005);
+    // Feed one sample to the filter.
+    void update( const TFMPSample &s);
+    // Call `callback` when time to contact drops below `ms`.
+    void onWarning( uint32_t ms, TFMPTTCCallback callback, void *context = NULL);
+    // Forget all history.
+    void reset();
+
+    int32_t  dist;      // filtered distance, in 1/256 distance units
+    int32_t  rate;      // closing rate in distance units per second,
+                        // positive when the target is approaching
+    uint32_t ttc;       // time to contact in milliseconds or TTC_NONE
+    uint32_t ttcMin;    // early bound on time to contact
+    uint32_t ttcMax;    // late bound on time to contact or TTC_NONE
+    bool     warning;   // time to contact is below the warning threshold
+
+  private:
+    uint16_t alpha;     // gains as fractions of 65536
+    uint16_t beta;
+    uint32_t gainV;     // prediction error to rate error factor, x65536
+
+    bool     started;
+    uint8_t  frames;
+    uint32_t lastTime;
+    uint32_t period;    // average time between samples in microseconds
+    int32_t  pos;       // filtered distance, x256
+    int32_t  vel;       // filtered velocity in units per second, x256
+    uint32_t var;       // variance of prediction error, in (1/16 unit)^2
+
+    uint32_t warnMs;
+    TFMPTTCCallback callback;
+    void *context;
+};
+
+#endif